@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inference/context.hpp"
+#include "inference/types.hpp"
+#include "inference/core/hash.hpp"
+#include "inference/core/shape.hpp"
+#include "inference/core/tuning_store.hpp"
+
+namespace inference {
+
+// one benchmarked candidate
+struct AutotuneTrial final {
+    ExecutionConfig execution;
+    BatchingConfig batching;
+    // completed runs per second under closed-loop load
+    double throughput{0.0};
+    // p99 of run() in nanoseconds
+    std::uint64_t p99_ns{0};
+    bool meets_slo{false};
+};
+
+struct AutotuneResult final {
+    // highest throughput meeting the SLO, or the lowest p99 if none does
+    AutotuneTrial best;
+    std::vector<AutotuneTrial> trials;
+};
+
+namespace detail {
+
+inline std::uint32_t cpu_cores() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+inline std::vector<std::uint32_t> powers_of_two(std::uint32_t limit) {
+    std::vector<std::uint32_t> values;
+    for (std::uint32_t value = 1; value <= limit; value *= 2) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+// runs `count` requests from `concurrency` closed-loop clients, returns the elapsed seconds
+inline double run_closed_loop(Context &context, const TensorView &input, std::uint32_t concurrency,
+                              std::uint32_t count) {
+    std::atomic<std::uint32_t> next{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+
+    const auto client = [&] {
+        while (next.fetch_add(1) < count) {
+            try {
+                context.run(input);
+            } catch (...) {
+                std::scoped_lock lock{mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(count);
+                return;
+            }
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> clients;
+    clients.reserve(concurrency);
+    for (std::uint32_t i = 0; i < concurrency; i++) {
+        clients.emplace_back(client);
+    }
+    for (auto &thread : clients) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace detail
+
+// Candidate (execution, batching) configs of a tuning run, fewest cores first.
+inline std::vector<AutotuneTrial> autotune_candidates(const AutotuneConfig &config, std::chrono::microseconds max_delay,
+                                                      std::uint32_t cores = detail::cpu_cores()) {
+    const auto threads = config.threads.empty() ? detail::powers_of_two(cores) : config.threads;
+    const auto instances = config.instances.empty() ? std::vector<std::uint32_t>{1, 2} : config.instances;
+    const auto batch_sizes = config.batch_sizes.empty() ? std::vector<std::uint32_t>{1, 4, 8} : config.batch_sizes;
+
+    std::vector<AutotuneTrial> candidates;
+    for (const std::uint32_t instance_count : instances) {
+        for (const std::uint32_t thread_count : threads) {
+            if (instance_count == 0 || thread_count == 0 || instance_count * thread_count > cores) {
+                continue;
+            }
+
+            for (const std::uint32_t batch_size : batch_sizes) {
+                if (batch_size == 0) {
+                    continue;
+                }
+
+                AutotuneTrial &candidate = candidates.emplace_back();
+                candidate.execution = {.threads = thread_count, .instances = instance_count};
+                candidate.batching = {.max_batch_size = batch_size, .max_delay = max_delay};
+            }
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+        return a.execution.threads * a.execution.instances < b.execution.threads * b.execution.instances;
+    });
+
+    return candidates;
+}
+
+// Benchmarks every candidate on a temporary copy of `context` (which keeps serving meanwhile),
+// then switches `context` to the best one.
+//
+// Each candidate runs `warmup` and then `requests` closed-loop runs of a single sample; throughput
+// and p99 come from the copy's latency stats. Among candidates meeting the SLO the highest
+// throughput wins (ties go to fewer cores); if none meets it, the lowest p99 wins.
+inline AutotuneResult autotune(Context &context, const AutotuneConfig &config) {
+    if (config.target_p99.count() <= 0) {
+        throw std::invalid_argument("Autotune target p99 must be positive");
+    }
+
+    if (config.requests == 0) {
+        throw std::invalid_argument("Autotune requests must be positive");
+    }
+
+    if (!context.reconfigurable()) {
+        throw std::logic_error("Context with a fixed backend cannot be autotuned");
+    }
+
+    Tensor input = config.input;
+    if (input.shape.empty()) {
+        input.shape = context.input_shape();
+        if (input.shape.empty()) {
+            throw std::invalid_argument("Autotune requires an input: the model input shape is not static");
+        }
+        input.data.assign(core::types::numel(input.shape), 0.0F);
+    }
+
+    const TensorView view{.shape = input.shape, .data = input.data};
+    const auto target_ns = static_cast<std::uint64_t>(std::chrono::nanoseconds(config.target_p99).count());
+
+    AutotuneResult result;
+    result.trials = autotune_candidates(config, context.config().batching.max_delay);
+
+    if (result.trials.empty()) {
+        throw std::invalid_argument("Autotune has no candidate configuration");
+    }
+
+    for (auto &trial : result.trials) {
+        const auto candidate = context.clone_with(trial.execution, trial.batching);
+        const std::uint32_t concurrency =
+            config.concurrency > 0 ? config.concurrency : trial.execution.instances * trial.batching.max_batch_size;
+
+        detail::run_closed_loop(*candidate, view, concurrency, config.warmup);
+        candidate->reset_latency_stats();
+
+        const double seconds = detail::run_closed_loop(*candidate, view, concurrency, config.requests);
+
+        trial.throughput = seconds > 0.0 ? config.requests / seconds : 0.0;
+        trial.p99_ns = candidate->latency_stats().run.quantile(0.99);
+        trial.meets_slo = trial.p99_ns <= target_ns;
+    }
+
+    // candidates are ordered by cores, so strict comparisons keep the cheaper of equal ones
+    result.best = result.trials.front();
+    for (const auto &trial : result.trials) {
+        const bool better = trial.meets_slo != result.best.meets_slo
+                                ? trial.meets_slo
+                                : (trial.meets_slo ? trial.throughput > result.best.throughput
+                                                   : trial.p99_ns < result.best.p99_ns);
+        if (better) {
+            result.best = trial;
+        }
+    }
+
+    context.reconfigure(result.best.execution, result.best.batching);
+    return result;
+}
+
+inline core::TunedConfig to_tuned_config(const AutotuneTrial &trial) {
+    return {.threads = trial.execution.threads,
+            .instances = trial.execution.instances,
+            .max_batch_size = trial.batching.max_batch_size,
+            .max_delay_us = static_cast<std::uint64_t>(trial.batching.max_delay.count())};
+}
+
+inline void apply_tuned_config(const core::TunedConfig &tuned, ModelConfig &config) {
+    config.execution = {.threads = tuned.threads, .instances = tuned.instances};
+    config.batching = {.max_batch_size = tuned.max_batch_size,
+                       .max_delay = std::chrono::microseconds(tuned.max_delay_us)};
+}
+
+// Content hash of the model (model_data, else the model_path file) and its device.
+inline std::uint64_t model_hash(const ModelConfig &config) {
+    std::uint64_t hash = 0;
+
+    if (!config.model_data.empty()) {
+        hash = core::hash_bytes(config.model_data.data(), config.model_data.size());
+    } else if (!config.model_path.empty()) {
+        std::ifstream in{config.model_path, std::ios::binary};
+        if (!in) {
+            throw std::runtime_error("Failed to read model file: " + config.model_path);
+        }
+
+        const std::vector<char> bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        hash = core::hash_bytes(bytes.data(), bytes.size());
+    }
+
+    return core::hash_combine(hash, core::hash_bytes(config.device.data(), config.device.size()));
+}
+
+} // namespace inference
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "inference/types.hpp"
+
+namespace inference {
+
+// Executes predicts for a Context.
+//
+// Inputs and outputs are batched along the first dimension: an input of
+// shape [N, ...] yields an output of shape [N, ...]. Implementations are
+// not required to be thread-safe; Context never calls one instance concurrently.
+class Backend {
+public:
+    virtual ~Backend() = default;
+
+    virtual Tensor predict(const TensorView &in) = 0;
+
+    // model input shape with a batch dimension of 1, empty if unknown (e.g. dynamic)
+    virtual Shape input_shape() const { return {}; }
+};
+
+} // namespace inference
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "inference/context.hpp"
+#include "inference/types.hpp"
+#include "inference/core/tensor_dataset.hpp"
+
+namespace inference {
+
+struct BatchRunnerConfig final {
+    // records per run(), concatenated along the first dimension. Only records of one shape with a
+    // leading batch dimension of 1 ([1, ...]) are concatenated; other batches run record by record.
+    std::uint32_t batch_size{1};
+    // concurrent run() calls
+    std::uint32_t workers{1};
+    // batches read ahead of the workers (page-cache prefetch)
+    std::uint32_t prefetch{4};
+    // write (labels, scores) of the k best values per row instead of full outputs (0 = full outputs)
+    std::uint32_t top_k{0};
+};
+
+struct BatchRunnerStats final {
+    std::uint64_t records{0};
+    std::uint64_t batches{0};
+    double seconds{0.0};
+};
+
+// Streams a memory-mapped dataset through a Context.
+//
+// Workers take batches in order, run them (a single record is passed to the model
+// straight from the mapping, without a copy) and hand the outputs to an in-order
+// writer, so output record i always belongs to input record i. Workers may run at
+// most `workers + prefetch` batches ahead of the writer, which bounds memory.
+//
+// Output: one FLOAT32 record per input record, or with `top_k` two records per input
+// record: INT32 labels [rows, k] followed by FLOAT32 scores [rows, k], best first.
+class BatchRunner final {
+public:
+    BatchRunner(Context &context, BatchRunnerConfig config) : context_{context}, config_{config} {
+        if (config_.batch_size == 0 || config_.workers == 0) {
+            throw std::invalid_argument("BatchRunner batch size and workers must be positive");
+        }
+    }
+
+    BatchRunnerStats run(const core::TensorDataset &input, core::TensorDatasetWriter &output) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const size_t batch_size = config_.batch_size;
+        const size_t batches = (input.size() + batch_size - 1) / batch_size;
+        const size_t window = config_.workers + config_.prefetch;
+
+        State state;
+        input.prefetch(0, window * batch_size);
+
+        const auto worker = [&] {
+            while (true) {
+                const size_t batch = state.next.fetch_add(1);
+                if (batch >= batches) {
+                    return;
+                }
+
+                {
+                    std::unique_lock lock{state.mutex};
+                    state.cv.wait(lock, [&] { return state.error || batch < state.written + window; });
+                    if (state.error) {
+                        return;
+                    }
+                }
+
+                // the batch entering the window once this one is written
+                input.prefetch((batch + window) * batch_size, batch_size);
+
+                try {
+                    const size_t first = batch * batch_size;
+                    auto outputs = run_batch(input, first, std::min(input.size(), first + batch_size));
+                    commit(state, output, batch, std::move(outputs));
+                } catch (...) {
+                    std::scoped_lock lock{state.mutex};
+                    if (!state.error) {
+                        state.error = std::current_exception();
+                    }
+                    state.cv.notify_all();
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(config_.workers);
+        for (std::uint32_t i = 0; i < config_.workers; i++) {
+            threads.emplace_back(worker);
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+
+        return {.records = input.size(),
+                .batches = batches,
+                .seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+    }
+
+private:
+    struct State final {
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::map<size_t, std::vector<Tensor>> pending; // finished batches waiting for their turn
+        size_t written{0};                             // batches written so far
+        bool writing{false};                           // a worker is draining `pending`
+        std::exception_ptr error;
+    };
+
+    // outputs of records [first, last), one tensor per record
+    std::vector<Tensor> run_batch(const core::TensorDataset &input, size_t first, size_t last) {
+        std::vector<core::TensorRecordView> records;
+        records.reserve(last - first);
+        for (size_t i = first; i < last; i++) {
+            records.push_back(input.record(i));
+        }
+
+        // [1, ...] records of one shape stack into [n, ...]; anything else ([C, H, W], [2, ...]) would
+        // be concatenated along the wrong axis
+        const bool batchable = records.size() > 1 && !records.front().shape.empty() &&
+                               records.front().shape[0] == 1 &&
+                               std::all_of(records.begin(), records.end(), [&](const auto &record) {
+                                   return record.shape == records.front().shape;
+                               });
+
+        std::vector<Tensor> outputs;
+        outputs.reserve(records.size());
+
+        if (!batchable) {
+            // zero-copy: the model reads straight from the mapping
+            for (const auto &record : records) {
+                outputs.push_back(context_.run(TensorView{.shape = record.shape, .data = record.floats()}));
+            }
+            return outputs;
+        }
+
+        const size_t record_size = records.front().floats().size();
+        std::vector<float> data;
+        data.reserve(records.size() * record_size);
+        for (const auto &record : records) {
+            const auto floats = record.floats();
+            data.insert(data.end(), floats.begin(), floats.end());
+        }
+
+        Shape shape = records.front().shape;
+        shape[0] = static_cast<std::uint32_t>(records.size());
+
+        const Tensor out = context_.run(TensorView{.shape = shape, .data = data});
+
+        if (out.shape.empty() || out.shape[0] != shape[0] || out.data.size() % records.size() != 0) {
+            throw std::runtime_error("Batched output does not match batch size");
+        }
+
+        // scatter along the first dimension
+        const size_t out_record_size = out.data.size() / records.size();
+        for (size_t i = 0; i < records.size(); i++) {
+            Tensor &result = outputs.emplace_back();
+            result.shape = out.shape;
+            result.shape[0] = records[i].shape[0];
+
+            const auto begin = out.data.begin() + static_cast<std::ptrdiff_t>(i * out_record_size);
+            result.data.assign(begin, begin + static_cast<std::ptrdiff_t>(out_record_size));
+        }
+
+        return outputs;
+    }
+
+    // queues a finished batch and writes every batch that is next in order. The file I/O runs
+    // outside the lock; a single worker at a time drains the queue, which keeps the output in order.
+    void commit(State &state, core::TensorDatasetWriter &output, size_t batch, std::vector<Tensor> outputs) {
+        std::unique_lock lock{state.mutex};
+        state.pending.emplace(batch, std::move(outputs));
+
+        if (state.writing) {
+            return; // the draining worker picks this batch up once it is next
+        }
+        state.writing = true;
+
+        while (!state.error && !state.pending.empty() && state.pending.begin()->first == state.written) {
+            const auto next = state.pending.extract(state.pending.begin());
+            lock.unlock();
+
+            try {
+                for (const Tensor &tensor : next.mapped()) {
+                    write(output, tensor);
+                }
+            } catch (...) {
+                lock.lock();
+                state.writing = false;
+                throw;
+            }
+
+            lock.lock();
+            state.written++;
+            state.cv.notify_all();
+        }
+
+        state.writing = false;
+    }
+
+    void write(core::TensorDatasetWriter &output, const Tensor &tensor) const {
+        if (config_.top_k == 0) {
+            output.append(tensor.data, tensor.shape);
+            return;
+        }
+
+        // rows along the first dimension, values = all remaining elements
+        const size_t rows = tensor.shape.empty() ? 1 : tensor.shape[0];
+        const size_t values = rows > 0 ? tensor.data.size() / rows : 0;
+        const size_t k = std::min<size_t>(config_.top_k, values);
+
+        std::vector<std::int32_t> labels(rows * k);
+        std::vector<float> scores(rows * k);
+        std::vector<std::int32_t> order(values);
+
+        for (size_t row = 0; row < rows; row++) {
+            const float *row_data = tensor.data.data() + row * values;
+
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(k), order.end(),
+                              [&](std::int32_t a, std::int32_t b) {
+                                  return row_data[a] > row_data[b] || (row_data[a] == row_data[b] && a < b);
+                              });
+
+            for (size_t j = 0; j < k; j++) {
+                labels[row * k + j] = order[j];
+                scores[row * k + j] = row_data[order[j]];
+            }
+        }
+
+        const Shape shape{static_cast<std::uint32_t>(rows), static_cast<std::uint32_t>(k)};
+        output.append({reinterpret_cast<const std::uint8_t *>(labels.data()), labels.size() * sizeof(std::int32_t)},
+                      shape, core::types::Layout::UNDEFINED, core::types::DataType::INT32);
+        output.append(scores, shape);
+    }
+
+    Context &context_;
+    const BatchRunnerConfig config_;
+};
+
+} // namespace inference
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "inference/types.hpp"
+#include "inference/core/latency_histogram.hpp"
+
+namespace inference {
+
+// Dynamic micro-batcher.
+//
+// Concurrent single-sample requests (shape [1, ...]) are queued and executed
+// as one batched predict once `max_batch_size` requests with the same shape
+// are waiting or the oldest one has waited `max_delay`. Results are split
+// along the first dimension and handed back to each caller.
+//
+// Other inputs bypass the queue and are predicted directly on the caller's
+// thread. `run()` blocks, so queued views stay valid until their result is set.
+// The time each queued request waits for its batch is recorded in `queue_wait`.
+// With several workers, batches are dispatched concurrently (one per worker).
+class Batcher final {
+public:
+    using PredictFn = std::function<Tensor(const TensorView &)>;
+
+    Batcher(BatchingConfig config, PredictFn predict, core::LatencyHistogram *queue_wait = nullptr,
+            std::uint32_t workers = 1)
+        : config_{config}, predict_{std::move(predict)}, queue_wait_{queue_wait} {
+        workers_.reserve(workers);
+        for (std::uint32_t i = 0; i < std::max<std::uint32_t>(1, workers); i++) {
+            workers_.emplace_back([this] { loop(); });
+        }
+    }
+
+    ~Batcher() {
+        {
+            std::scoped_lock lock{mutex_};
+            stopping_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    Batcher(const Batcher &) = delete;
+    Batcher &operator=(const Batcher &) = delete;
+
+    static bool batchable(const TensorView &in) { return !in.shape.empty() && in.shape[0] == 1; }
+
+    Tensor run(const TensorView &in) {
+        if (!batchable(in)) {
+            return predict_(in);
+        }
+
+        Request request{&in, Clock::now(), 0, {}};
+        auto result = request.promise.get_future();
+
+        {
+            std::scoped_lock lock{mutex_};
+            if (stopping_) {
+                throw std::runtime_error("Batcher is stopped");
+            }
+            request.sequence = next_sequence_++;
+            queue_.push_back(&request);
+        }
+        cv_.notify_all();
+
+        return result.get();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request final {
+        const TensorView *input;
+        Clock::time_point arrival;
+        // enqueue order; unlike the address it is never reused by a later request
+        std::uint64_t sequence;
+        std::promise<Tensor> promise;
+    };
+
+    void loop() {
+        std::unique_lock lock{mutex_};
+
+        while (true) {
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+            if (queue_.empty()) {
+                return; // stopping, nothing left to serve
+            }
+
+            const std::uint64_t oldest = queue_.front()->sequence;
+            const auto deadline = queue_.front()->arrival + config_.max_delay;
+
+            // only requests shaped like the oldest one join its batch, so only they make it full
+            cv_.wait_until(lock, deadline, [this, oldest] {
+                return stopping_ || queue_.empty() || queue_.front()->sequence != oldest ||
+                       batchable_with_oldest() >= config_.max_batch_size;
+            });
+
+            // another worker took the oldest request meanwhile: wait for the new oldest one
+            if (queue_.empty() || (queue_.front()->sequence != oldest && !stopping_)) {
+                continue;
+            }
+
+            auto batch = take_batch();
+
+            lock.unlock();
+            execute(batch);
+            lock.lock();
+        }
+    }
+
+    static bool same_shape(const TensorView &a, const TensorView &b) {
+        return a.shape == b.shape && a.data.size() == b.data.size();
+    }
+
+    // queued requests that can share a batch with the oldest one (including it)
+    size_t batchable_with_oldest() const {
+        const TensorView &oldest = *queue_.front()->input;
+        return static_cast<size_t>(std::count_if(queue_.begin(), queue_.end(), [&oldest](const Request *request) {
+            return same_shape(*request->input, oldest);
+        }));
+    }
+
+    // takes up to max_batch_size requests sharing the oldest request's shape (FIFO otherwise)
+    std::vector<Request *> take_batch() {
+        std::vector<Request *> batch;
+        batch.reserve(config_.max_batch_size);
+
+        const TensorView &oldest = *queue_.front()->input;
+        for (auto it = queue_.begin(); it != queue_.end() && batch.size() < config_.max_batch_size;) {
+            if (same_shape(*(*it)->input, oldest)) {
+                batch.push_back(*it);
+                it = queue_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        return batch;
+    }
+
+    void execute(const std::vector<Request *> &batch) {
+        if (queue_wait_ != nullptr) {
+            const auto now = Clock::now();
+            for (const Request *request : batch) {
+                queue_wait_->record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - request->arrival).count()));
+            }
+        }
+
+        std::vector<Tensor> results;
+
+        try {
+            results = batch.size() == 1 ? std::vector<Tensor>{predict_(*batch.front()->input)} : predict_batch(batch);
+        } catch (...) {
+            for (Request *request : batch) {
+                request->promise.set_exception(std::current_exception());
+            }
+            return;
+        }
+
+        // the request may be destroyed as soon as its promise is satisfied
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i]->promise.set_value(std::move(results[i]));
+        }
+    }
+
+    std::vector<Tensor> predict_batch(const std::vector<Request *> &batch) {
+        const size_t batch_size = batch.size();
+        const size_t sample_size = batch.front()->input->data.size();
+
+        std::vector<float> data;
+        data.reserve(batch_size * sample_size);
+        for (const Request *request : batch) {
+            data.insert(data.end(), request->input->data.begin(), request->input->data.end());
+        }
+
+        Shape shape = batch.front()->input->shape;
+        shape[0] = static_cast<std::uint32_t>(batch_size);
+
+        const Tensor out = predict_(TensorView{.shape = shape, .data = data});
+
+        if (out.shape.empty() || out.shape[0] != batch_size || out.data.size() % batch_size != 0) {
+            throw std::runtime_error("Batched output does not match batch size");
+        }
+
+        // scatter along the first dimension
+        const size_t out_sample_size = out.data.size() / batch_size;
+        std::vector<Tensor> results(batch_size);
+
+        for (size_t i = 0; i < batch_size; i++) {
+            results[i].shape = out.shape;
+            results[i].shape[0] = 1;
+
+            const auto first = out.data.begin() + static_cast<std::ptrdiff_t>(i * out_sample_size);
+            results[i].data.assign(first, first + static_cast<std::ptrdiff_t>(out_sample_size));
+        }
+
+        return results;
+    }
+
+    const BatchingConfig config_;
+    const PredictFn predict_;
+    core::LatencyHistogram *const queue_wait_; // optional, owned by the caller
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request *> queue_;
+    std::uint64_t next_sequence_{0};
+    bool stopping_{false};
+
+    std::vector<std::thread> workers_; // started in the constructor body, after all state above is initialized
+};
+
+} // namespace inference
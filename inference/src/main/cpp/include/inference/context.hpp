@@ -1,203 +1,284 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
-#include <string>
 #include <vector>
-#include <sstream>
-#include <iostream>
 
+#include "inference/backend.hpp"
+#include "inference/batcher.hpp"
 #include "inference/types.hpp"
-
-// MindSpore Lite
-#include <mindspore/context.h>
-#include <mindspore/model.h>
-#include <mindspore/tensor.h>
-#include <mindspore/types.h>
-#include <mindspore/status.h>
+#include "inference/core/detection.hpp"
+#include "inference/core/latency_histogram.hpp"
+#include "inference/core/lru_cache.hpp"
+#include "inference/core/tensor_key.hpp"
 
 namespace inference {
 
-struct MSContext final {
-    OH_AI_ContextHandle handle{nullptr};
+// Latency histograms (nanoseconds) recorded by every Context.
+struct LatencyStats final {
+    core::LatencySnapshot run;        // run() calls, entry to return (cache hits included)
+    core::LatencySnapshot queue_wait; // per predicted request: waiting for its micro-batch or the model lock
+    core::LatencySnapshot predict;    // backend predict calls (one per batch)
+};
 
-    MSContext() {
-        handle = OH_AI_ContextCreate();
-        if (!handle) {
-            throw std::runtime_error("OH_AI_ContextCreate returned null");
+// Runs a model on a pool of backend instances.
+//
+// Each instance is used by one predict at a time; concurrent predicts wait for an idle
+// instance. A Context built from a factory can rebuild its pool with another execution
+// and batching config while in use (reconfigure), e.g. after autotuning.
+struct Context final {
+public:
+    using BackendFactory = std::function<std::unique_ptr<Backend>(const ModelConfig &)>;
+
+    // a single, fixed backend (cannot be reconfigured)
+    Context(ModelConfig config, std::unique_ptr<Backend> backend) : config_{std::move(config)} {
+        if (!backend) {
+            throw std::invalid_argument("Context requires a backend");
         }
+
+        config_.execution.instances = 1;
+        std::vector<std::unique_ptr<Backend>> backends;
+        backends.push_back(std::move(backend));
+        init(std::move(backends));
     }
 
-    ~MSContext() {
-        if (handle) {
-            OH_AI_ContextDestroy(&handle);
+    // `config.execution.instances` backends built by `factory`
+    Context(ModelConfig config, BackendFactory factory) : config_{std::move(config)}, factory_{std::move(factory)} {
+        if (!factory_) {
+            throw std::invalid_argument("Context requires a backend factory");
         }
-    }
-};
 
-struct MSDeviceInfo final {
-    OH_AI_DeviceInfoHandle handle{nullptr};
+        init(build_backends(config_));
+    }
 
-    explicit MSDeviceInfo(OH_AI_DeviceType type) {
-        handle = OH_AI_DeviceInfoCreate(type);
+    // keeps Context(config, nullptr) unambiguous (throws like a null backend)
+    Context(ModelConfig config, std::nullptr_t) : Context(std::move(config), std::unique_ptr<Backend>{}) {}
 
-        if (!handle) {
-            throw std::runtime_error("OH_AI_DeviceInfoCreate returned null");
+    Tensor run(const TensorView &in) {
+        const auto start = Clock::now();
+        Tensor out;
+        {
+            std::shared_lock state{state_mutex_};
+            out = run_cached(in);
         }
+        record(run_latency_, Clock::now() - start);
+        return out;
     }
 
-    ~MSDeviceInfo() {
-        if (handle) {
-//            OH_AI_DeviceInfoDestroy(&handle);
+    // runs a detector on a single image and postprocesses its [1, rows, row_size] (or [rows, row_size])
+    // output natively; batched inputs are rejected, as their rows would share one NMS
+    core::Detections detect(const TensorView &in) {
+        if (!config_.detection) {
+            throw std::runtime_error("Context has no detection config");
+        }
+
+        if (in.shape.empty() || in.shape[0] != 1) {
+            throw std::invalid_argument("detect() requires a single image (batch size 1)");
         }
-    }
-};
 
-struct MSModel final {
-    OH_AI_ModelHandle handle{nullptr};
+        const Tensor out = run(in);
 
-    MSModel() {
-        handle = OH_AI_ModelCreate();
-        if (!handle) {
-            throw std::runtime_error("OH_AI_ModelCreate returned null");
+        if (out.shape.size() > 2 && out.shape[0] != 1) {
+            throw std::runtime_error("Detector output has a batch size other than 1");
         }
+
+        const size_t row_size = out.shape.empty() ? out.data.size() : out.shape.back();
+        const size_t num_rows = row_size > 0 ? out.data.size() / row_size : 0;
+
+        return core::postprocess_detections(out.data, num_rows, *config_.detection);
     }
-    ~MSModel() {
-        if (handle) {
-            OH_AI_ModelDestroy(&handle);
-        }
+
+    core::CacheStats cache_stats() const { return cache_ ? cache_->stats() : core::CacheStats{}; }
+
+    LatencyStats latency_stats() const {
+        return {.run = run_latency_.snapshot(), .queue_wait = queue_wait_.snapshot(), .predict = predict_.snapshot()};
     }
-};
 
-inline void check(OH_AI_Status status, const char *what) {
-    if (status != OH_AI_STATUS_SUCCESS) {
-        std::ostringstream os;
-        os << what << " failed, status=0x" << std::hex << static_cast<uint32_t>(status);
-        throw std::runtime_error(os.str());
+    void reset_latency_stats() {
+        run_latency_.reset();
+        queue_wait_.reset();
+        predict_.reset();
     }
-}
 
-inline std::string shape_to_string(const int64_t *shape, size_t num) {
-    std::ostringstream os;
-    os << "[";
-    for (size_t i = 0; i < num; i++) {
-        if (i) {
-            os << ", ";
-        }
-        os << shape[i];
+    ModelConfig config() const {
+        std::shared_lock state{state_mutex_};
+        return config_;
     }
-    os << "]";
-    return os.str();
-}
 
-inline void dump_tensor(OH_AI_TensorHandle tensor, const char *kind, size_t idx) {
-    const char *name = OH_AI_TensorGetName(tensor);
-    OH_AI_DataType data_type = OH_AI_TensorGetDataType(tensor);
+    // model input shape with a batch dimension of 1, empty if unknown
+    Shape input_shape() const {
+        std::shared_lock state{state_mutex_};
+        return backends_.front()->input_shape();
+    }
 
-    size_t shape_num = 0;
-    const int64_t *shape = OH_AI_TensorGetShape(tensor, &shape_num);
+    bool reconfigurable() const { return static_cast<bool>(factory_); }
 
-    size_t bytes = OH_AI_TensorGetDataSize(tensor);
+    // Rebuilds the backend pool and batcher. New backends are built first; the switch then
+    // waits for in-flight runs. On failure the current configuration stays in place.
+    void reconfigure(ExecutionConfig execution, BatchingConfig batching) {
+        ModelConfig next = config();
+        next.execution = execution;
+        next.batching = batching;
 
-    std::ostringstream os;
+        auto backends = build_backends(next);
 
-    os << kind << "[" << idx << "] "
-       << "name=" << (name ? name : "<null>") << " dtype=" << static_cast<int>(data_type)
-       << " shape=" << (shape ? shape_to_string(shape, shape_num) : "<null>") << " bytes=" << bytes;
+        std::unique_lock state{state_mutex_};
+        batcher_.reset(); // idle: no run holds the state lock
+        config_.execution = next.execution;
+        config_.batching = next.batching;
+        init(std::move(backends));
+    }
 
-    auto str = os.str();
+    // A new Context for the same model with another execution and batching config
+    // (no result cache), e.g. to benchmark a candidate configuration.
+    std::unique_ptr<Context> clone_with(ExecutionConfig execution, BatchingConfig batching) const {
+        if (!factory_) {
+            throw std::logic_error("Context with a fixed backend cannot be cloned");
+        }
 
-    std::cerr << str << std::endl;
-}
+        ModelConfig config = this->config();
+        config.execution = execution;
+        config.batching = batching;
+        config.cache = {};
+        return std::make_unique<Context>(std::move(config), factory_);
+    }
 
-struct Context final {
-public:
-    explicit Context(ModelConfig config) : config_{std::move(config)} {}
+private:
+    using Clock = std::chrono::steady_clock;
+    using ResultCache = core::LruCache<core::TensorKey, Tensor, core::TensorKeyHash>;
 
-    Tensor run(const TensorView &in) {
-        [[maybe_unused]] std::scoped_lock lock{mutex_};
+    static void record(core::LatencyHistogram &histogram, Clock::duration duration) {
+        histogram.record(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
 
-        MSContext ctx;
-        OH_AI_ContextSetThreadNum(ctx.handle, 1);
-        OH_AI_ContextSetThreadAffinityMode(ctx.handle, 0);
+    Tensor run_cached(const TensorView &in) {
+        if (!cache_) {
+            return predict(in);
+        }
 
-        MSDeviceInfo cpu_device{OH_AI_DEVICETYPE_CPU};
-        OH_AI_ContextAddDeviceInfo(ctx.handle, cpu_device.handle);
+        // hashing happens outside of the model lock, so cache hits never wait behind a predict
+        const auto key =
+            core::make_tensor_key(in.data.data(), in.data.size_bytes(), in.shape, core::types::DataType::FLOAT32);
 
-        // build model from raw buffer
-        MSModel model;
-        auto status = OH_AI_ModelBuild(model.handle, config_.model_data.data(), config_.model_data.size(),
-                                       OH_AI_MODELTYPE_MINDIR, ctx.handle);
+        if (auto hit = cache_->get(key)) {
+            return *hit;
+        }
 
-        check(status, "OH_AI_ModelBuild");
+        auto out = std::make_shared<const Tensor>(predict(in));
+        cache_->put(key, out, out->data.size() * sizeof(float));
+        return *out;
+    }
 
+    Tensor predict(const TensorView &in) {
+        // single-sample requests are coalesced with concurrent ones when batching is enabled
+        return batcher_ && Batcher::batchable(in) ? batcher_->run(in) : predict_pooled(in, true);
+    }
 
-        // Fetch model inputs
-        auto inputs = OH_AI_ModelGetInputs(model.handle);
+    Tensor predict_pooled(const TensorView &in, bool record_wait) {
+        const auto arrival = Clock::now();
+        Backend *backend = acquire();
 
-        if (inputs.handle_num != 1 || inputs.handle_list == nullptr) {
-            throw std::runtime_error("Expected exactly 1 input tensor");
+        const auto start = Clock::now();
+        if (record_wait) {
+            record(queue_wait_, start - arrival);
         }
 
-        OH_AI_TensorHandle input0 = inputs.handle_list[0];
-
-        // Validate dtype
-        const OH_AI_DataType dt = OH_AI_TensorGetDataType(input0);
-        if (dt != OH_AI_DATATYPE_NUMBERTYPE_FLOAT32) { // name may vary; use your header’s exact enum
-            throw std::runtime_error("Model input dtype is not float32");
+        try {
+            Tensor out = backend->predict(in);
+            record(predict_, Clock::now() - start);
+            release(backend);
+            return out;
+        } catch (...) {
+            release(backend);
+            throw;
         }
+    }
 
-        // Expect [1,3,224,224]
-        size_t shape_rank = 0;
-        const int64_t *shape_ptr = OH_AI_TensorGetShape(input0, &shape_rank);
+    Backend *acquire() {
+        std::unique_lock lock{mutex_};
+        idle_cv_.wait(lock, [this] { return !idle_.empty(); });
 
-        if (shape_rank != 4 || shape_ptr[0] != 1 || shape_ptr[1] != 3 || shape_ptr[2] != 224 || shape_ptr[3] != 224) {
-            throw std::runtime_error("Model input shape mismatch");
-        }
+        Backend *backend = idle_.back();
+        idle_.pop_back();
+        return backend;
+    }
 
-        // Validate buffer sizes and copy input
-        const size_t expected_elems = 1 * 3 * 224 * 224;
-        if (in.data.size() != expected_elems) {
-            throw std::runtime_error("Input length mismatch (expected 150528 floats)");
+    void release(Backend *backend) {
+        {
+            std::scoped_lock lock{mutex_};
+            idle_.push_back(backend);
         }
+        idle_cv_.notify_one();
+    }
 
-        void *dst = OH_AI_TensorGetMutableData(input0);
-        const size_t dst_bytes = OH_AI_TensorGetDataSize(input0);
-        if (!dst || dst_bytes != expected_elems * sizeof(float)) {
-            throw std::runtime_error("Input tensor buffer invalid size");
+    std::vector<std::unique_ptr<Backend>> build_backends(const ModelConfig &config) const {
+        if (!factory_) {
+            throw std::logic_error("Context with a fixed backend cannot be reconfigured");
         }
 
-        std::memcpy(dst, in.data.data(), dst_bytes);
-
-        // Predict
-        OH_AI_TensorHandleArray outputs{};
-        check(OH_AI_ModelPredict(model.handle, inputs, &outputs, nullptr, nullptr), "OH_AI_ModelPredict");
+        if (config.execution.instances == 0 || config.execution.threads == 0) {
+            throw std::invalid_argument("Execution threads and instances must be positive");
+        }
 
-        if (outputs.handle_num != 1 || outputs.handle_list == nullptr) {
-            throw std::runtime_error("Expected exactly 1 output tensor");
+        std::vector<std::unique_ptr<Backend>> backends;
+        for (std::uint32_t i = 0; i < config.execution.instances; i++) {
+            backends.push_back(factory_(config));
+            if (!backends.back()) {
+                throw std::runtime_error("Backend factory returned null");
+            }
         }
+        return backends;
+    }
 
-        OH_AI_TensorHandle out0 = outputs.handle_list[0];
+    // installs a backend pool and batcher for config_ (constructor or exclusive state lock)
+    void init(std::vector<std::unique_ptr<Backend>> backends) {
+        {
+            std::scoped_lock lock{mutex_};
+            backends_ = std::move(backends);
+            idle_.clear();
+            for (const auto &backend : backends_) {
+                idle_.push_back(backend.get());
+            }
+        }
 
-        // 6) Read output and copy to our Tensor
-        const size_t out_bytes = OH_AI_TensorGetDataSize(out0);
-        const void *out_ptr = OH_AI_TensorGetData(out0);
+        // the span is only read while backends are built
+        config_.model_data = {};
 
-        if (!out_ptr || out_bytes != 1000 * sizeof(float)) {
-            throw std::runtime_error("Output tensor buffer invalid size");
+        if (config_.cache.enabled() && !cache_) {
+            cache_ = std::make_unique<ResultCache>(config_.cache.max_entries, config_.cache.max_bytes);
         }
 
-        Tensor out;
-        out.shape = {1, 1000};
-        out.data.resize(1000);
-        std::memcpy(out.data.data(), out_ptr, out_bytes);
-
-        return out;
+        if (config_.batching.enabled()) {
+            // the batcher records its own queue wait; one worker per instance keeps all of them busy
+            batcher_ = std::make_unique<Batcher>(
+                config_.batching, [this](const TensorView &in) { return predict_pooled(in, false); }, &queue_wait_,
+                static_cast<std::uint32_t>(backends_.size()));
+        }
     }
 
-private:
-    mutable std::mutex mutex_;
+    // run() holds it shared; reconfigure() holds it exclusively while switching
+    mutable std::shared_mutex state_mutex_;
     ModelConfig config_;
+    const BackendFactory factory_; // empty for a fixed backend
+
+    std::mutex mutex_; // guards idle_
+    std::condition_variable idle_cv_;
+    std::vector<std::unique_ptr<Backend>> backends_;
+    std::vector<Backend *> idle_;
+
+    std::unique_ptr<ResultCache> cache_; // null unless opted in
+    core::LatencyHistogram run_latency_;
+    core::LatencyHistogram queue_wait_;
+    core::LatencyHistogram predict_;
+    std::unique_ptr<Batcher> batcher_; // null unless opted in; declared last so it stops first
 };
 
 } // namespace inference
\ No newline at end of file
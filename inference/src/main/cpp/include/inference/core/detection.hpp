@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, int32_t
+#include <span>
+#include <vector>
+
+namespace inference::core {
+
+/**
+ * Encoding of the four box values of a prediction row.
+ *
+ * - CORNERS: (x1, y1, x2, y2)
+ * - CENTER: (cx, cy, w, h)
+ *
+ * Anchor and grid decoding always read CENTER-style deltas.
+ */
+enum class BoxFormat : uint32_t {
+  CORNERS = 0,
+  CENTER,
+};
+
+/**
+ * How raw box values are turned into boxes.
+ *
+ * - NONE: values are already boxes in `BoxFormat`.
+ * - ANCHORS: SSD-style deltas against per-row anchors (cx, cy, w, h):
+ *   cx = a.cx + dx * v0 * a.w, w = a.w * exp(dw * v2) (same for y/h).
+ * - GRID: anchor-free (YOLOX-style) offsets against grid cells, with
+ *   rows ordered by stride, then row-major within each level:
+ *   cx = (gx + dx) * stride, w = exp(dw) * stride (same for y/h).
+ */
+enum class BoxDecoding : uint32_t {
+  NONE = 0,
+  ANCHORS,
+  GRID,
+};
+
+struct DetectionConfig {
+  uint32_t num_classes = 0;
+
+  /**
+   * Row layout: each prediction row holds 4 box values at `box_offset`,
+   * an optional objectness value at `objectness_offset` (-1 if absent)
+   * and `num_classes` class scores starting at `class_offset`.
+   */
+  uint32_t box_offset = 0;
+  int32_t objectness_offset = -1;
+  uint32_t class_offset = 4;
+
+  BoxFormat box_format = BoxFormat::CENTER;
+  BoxDecoding decoding = BoxDecoding::NONE;
+
+  /**
+   * ANCHORS: one (cx, cy, w, h) anchor per row, and delta variances.
+   */
+  std::vector<float> anchors;
+  std::array<float, 4> variances{0.1F, 0.1F, 0.2F, 0.2F};
+
+  /**
+   * GRID: model input size and feature-map strides (e.g. 8, 16, 32).
+   */
+  uint32_t input_width = 0;
+  uint32_t input_height = 0;
+  std::vector<uint32_t> strides;
+
+  /**
+   * Apply a sigmoid to objectness and class values (raw logits).
+   */
+  bool sigmoid = false;
+
+  /**
+   * Emit a candidate for every class above the threshold instead of
+   * only the best class of each row.
+   */
+  bool multi_label = false;
+
+  /**
+   * Suppress across classes instead of within each class.
+   */
+  bool class_agnostic = false;
+
+  float score_threshold = 0.25F;
+  float iou_threshold = 0.45F;
+
+  /**
+   * Maximum number of returned detections (0 = unlimited).
+   */
+  uint32_t max_detections = 100;
+
+  /**
+   * Highest-scoring candidates kept for NMS, bounding the O(N^2) pass
+   * (0 = unlimited).
+   */
+  uint32_t max_candidates = 4096;
+};
+
+/**
+ * Final detections, best first, as parallel arrays.
+ *
+ * `boxes` holds (x1, y1, x2, y2) per detection.
+ */
+struct Detections {
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  std::vector<uint32_t> labels;
+
+  size_t size() const { return scores.size(); }
+};
+
+/**
+ * Filters, decodes and suppresses raw detector output.
+ *
+ * Pipeline: score threshold (before any box is decoded), top
+ * `max_candidates` selection, box decoding of the survivors only, then
+ * greedy NMS over score-sorted, structure-of-arrays boxes. Class-wise
+ * NMS only compares boxes sharing a label, in the same single pass.
+ *
+ * Invalid layouts (offsets outside the row, anchor or grid size not
+ * matching the number of rows) throw std::invalid_argument.
+ *
+ * @param predictions Row-major prediction rows
+ * @param num_rows Number of rows (candidate boxes)
+ * @param config Layout, decoding and NMS parameters
+ * @return Final detections
+ */
+Detections postprocess_detections(std::span<const float> predictions, size_t num_rows,
+                                  const DetectionConfig &config);
+
+} // namespace inference::core
@@ -15,6 +15,8 @@ enum class DataType : uint32_t {
   UNDEFINED = 0,
   FLOAT32,
   UINT8,
+  INT8,
+  INT32,
 };
 
 /**
@@ -30,8 +32,10 @@ enum class DataType : uint32_t {
 inline size_t element_size(DataType dtype) {
   switch (dtype) {
   case DataType::FLOAT32:
+  case DataType::INT32:
     return 4;
   case DataType::UINT8:
+  case DataType::INT8:
     return 1;
   default:
     return 0;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+namespace inference::core {
+
+/**
+ * Computes a fast, non-cryptographic 64-bit hash of a byte range.
+ *
+ * The long-input path follows the XXH3 stripe/accumulate scheme and
+ * is vectorized with NEON or SSE2 where available (scalar otherwise).
+ * All code paths produce identical results for the same input, so
+ * hashes are stable across devices of the same endianness.
+ *
+ * Conventions:
+ * - Intended for cache keys and deduplication, not for security.
+ * - Input memory does not need to be aligned.
+ * - Not compatible with reference xxHash outputs.
+ *
+ * @param data Pointer to the first byte (may be null if size is 0)
+ * @param size Number of bytes to hash
+ * @param seed Optional seed to derive independent hash functions
+ * @return 64-bit hash value
+ */
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed = 0);
+
+/**
+ * Mixes a 64-bit value into an existing hash.
+ *
+ * Used to fold small metadata (dimensions, enum values) into a
+ * content hash without hashing them as a separate byte range.
+ *
+ * @param hash Current hash value
+ * @param value Value to combine
+ * @return Combined hash value
+ */
+inline uint64_t hash_combine(uint64_t hash, uint64_t value) {
+  hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+} // namespace inference::core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint> // uint32_t
+#include <span>
+#include <vector>
+
+#include "inference/core/layout.hpp"
+
+namespace inference::core {
+
+/**
+ * Non-owning view of a single float image.
+ *
+ * Layout is NCHW (planar) or NHWC (interleaved); the batch dimension
+ * is implicitly 1.
+ */
+struct ImageView {
+  std::span<const float> data;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t channels = 0;
+  types::Layout layout = types::Layout::NCHW;
+};
+
+/**
+ * Region of interest in source pixel coordinates, (x1, y1) inclusive
+ * top-left corner and (x2, y2) exclusive bottom-right corner.
+ */
+struct Roi {
+  float x1 = 0.0F;
+  float y1 = 0.0F;
+  float x2 = 0.0F;
+  float y2 = 0.0F;
+};
+
+/**
+ * Per-channel normalization applied after resampling:
+ * out = (value - mean[c]) / std[c].
+ *
+ * Empty vectors mean identity; otherwise one value per channel, with
+ * non-zero `std` values.
+ */
+struct Normalization {
+  std::vector<float> mean;
+  std::vector<float> std;
+};
+
+/**
+ * Crops a region, resizes it with bilinear sampling and normalizes it
+ * in a single pass.
+ *
+ * Sampling uses half-pixel centers (align_corners = false); samples
+ * outside the image are clamped to the border. Column indices and
+ * weights are computed once per call, rows are processed sequentially.
+ *
+ * Conventions:
+ * - `dst` must hold `out_width * out_height * src.channels` floats.
+ * - An empty or inverted ROI is widened to one source pixel.
+ * - Invalid arguments (sizes, layout, normalization length, zero std,
+ *   non-finite ROI coordinates) throw std::invalid_argument.
+ *
+ * @param src Source image
+ * @param roi Region of interest in source pixels
+ * @param out_width Output width
+ * @param out_height Output height
+ * @param out_layout Output layout (NCHW or NHWC)
+ * @param norm Normalization applied to every output value
+ * @param dst Output buffer
+ */
+void crop_resize_normalize(const ImageView &src, const Roi &roi, uint32_t out_width, uint32_t out_height,
+                           types::Layout out_layout, const Normalization &norm, float *dst);
+
+} // namespace inference::core
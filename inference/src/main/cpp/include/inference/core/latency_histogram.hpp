@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <vector>
+
+namespace inference::core {
+
+/**
+ * Point-in-time copy of a `LatencyHistogram`.
+ *
+ * Values are in the unit they were recorded in (nanoseconds by
+ * convention). Snapshots of several histograms can be merged.
+ */
+struct LatencySnapshot {
+  std::vector<uint64_t> counts; // per bucket, see `LatencyHistogram::bucket_upper`
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t min = 0;
+  uint64_t max = 0;
+
+  double mean() const { return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+  /**
+   * Value at or below which the given fraction of samples falls.
+   *
+   * Returns the upper bound of the containing bucket (clamped to
+   * [`min`, `max`]), i.e. the result overestimates by at most one
+   * bucket width; quantile 0 is exactly `min`.
+   *
+   * @param quantile Fraction in [0, 1], e.g. 0.99 for p99
+   * @return Quantile value, 0 if empty
+   */
+  uint64_t quantile(double quantile) const;
+
+  void merge(const LatencySnapshot &other);
+};
+
+/**
+ * Lock-free log-linear histogram of latencies.
+ *
+ * Every power of two is split into 32 linear sub-buckets, so values
+ * are kept with a relative error below 1/32 (~3%) across the whole
+ * range; values below 32 are exact. Values at or above 2^40 (about 18
+ * minutes in nanoseconds) land in the last bucket.
+ *
+ * Conventions:
+ * - `record` is wait-free (relaxed atomics) and may be called from any
+ *   thread; snapshots taken concurrently are not atomic across counters.
+ * - The histogram has a fixed size (~9 KiB) and never allocates.
+ */
+class LatencyHistogram {
+public:
+  static constexpr uint32_t kSubBucketBits = 5;
+  static constexpr uint32_t kMaxBits = 40;
+  static constexpr size_t kBucketCount = (kMaxBits - kSubBucketBits + 1) << kSubBucketBits;
+
+  void record(uint64_t value);
+
+  LatencySnapshot snapshot() const;
+
+  void reset();
+
+  /**
+   * @return Bucket containing `value`
+   */
+  static size_t bucket_index(uint64_t value);
+
+  /**
+   * @return Largest value mapped to bucket `index`
+   */
+  static uint64_t bucket_upper(size_t index);
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+} // namespace inference::core
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace inference::core {
+
+/**
+ * Snapshot of cache counters.
+ *
+ * Counters are cumulative since construction (or the last `clear()`
+ * for `entries` and `bytes`, which describe the current contents).
+ */
+struct CacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t insertions = 0;
+  uint64_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;
+};
+
+/**
+ * Thread-safe least-recently-used cache with entry and byte budgets.
+ *
+ * Values are stored as `shared_ptr<const Value>` so lookups hand out
+ * a reference without copying the payload under the lock, and an
+ * evicted value stays alive for readers that still hold it.
+ *
+ * Conventions:
+ * - `max_entries == 0` or `max_bytes == 0` means "no limit" for that budget.
+ * - A value whose cost alone exceeds `max_bytes` is not inserted.
+ * - All methods may be called concurrently.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+  using ValuePtr = std::shared_ptr<const Value>;
+
+  LruCache(size_t max_entries, size_t max_bytes) : max_entries_{max_entries}, max_bytes_{max_bytes} {}
+
+  LruCache(const LruCache &) = delete;
+  LruCache &operator=(const LruCache &) = delete;
+
+  /**
+   * Looks up a key and marks it as most recently used.
+   *
+   * @param key Lookup key
+   * @return Cached value, or null on miss
+   */
+  ValuePtr get(const Key &key) {
+    std::scoped_lock lock{mutex_};
+
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+
+    order_.splice(order_.begin(), order_, it->second);
+    ++stats_.hits;
+    return it->second->value;
+  }
+
+  /**
+   * Inserts or replaces a value, evicting least recently used entries
+   * until both budgets are satisfied.
+   *
+   * @param key Cache key
+   * @param value Value to store
+   * @param cost Accounted size of the value in bytes
+   */
+  void put(const Key &key, ValuePtr value, size_t cost) {
+    if (max_bytes_ != 0 && cost > max_bytes_) {
+      return;
+    }
+
+    std::scoped_lock lock{mutex_};
+
+    if (auto it = index_.find(key); it != index_.end()) {
+      stats_.bytes -= it->second->cost;
+      order_.erase(it->second);
+      index_.erase(it);
+    }
+
+    order_.push_front(Entry{key, std::move(value), cost});
+    index_.emplace(key, order_.begin());
+    stats_.bytes += cost;
+    ++stats_.insertions;
+
+    while (over_budget()) {
+      const Entry &victim = order_.back();
+      stats_.bytes -= victim.cost;
+      index_.erase(victim.key);
+      order_.pop_back();
+      ++stats_.evictions;
+    }
+  }
+
+  /**
+   * Removes all entries. Hit/miss counters are preserved.
+   */
+  void clear() {
+    std::scoped_lock lock{mutex_};
+    index_.clear();
+    order_.clear();
+    stats_.bytes = 0;
+  }
+
+  CacheStats stats() const {
+    std::scoped_lock lock{mutex_};
+    CacheStats snapshot = stats_;
+    snapshot.entries = index_.size();
+    return snapshot;
+  }
+
+private:
+  struct Entry {
+    Key key;
+    ValuePtr value;
+    size_t cost;
+  };
+
+  using Order = std::list<Entry>;
+
+  bool over_budget() const {
+    if (order_.empty()) {
+      return false;
+    }
+    return (max_entries_ != 0 && index_.size() > max_entries_) || (max_bytes_ != 0 && stats_.bytes > max_bytes_);
+  }
+
+  const size_t max_entries_;
+  const size_t max_bytes_;
+
+  mutable std::mutex mutex_;
+  Order order_; // front = most recently used
+  std::unordered_map<Key, typename Order::iterator, Hash> index_;
+  CacheStats stats_;
+};
+
+} // namespace inference::core
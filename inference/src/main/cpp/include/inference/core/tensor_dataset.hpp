@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint32_t, uint64_t
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "inference/core/tensor.hpp"
+
+namespace inference::core {
+
+/**
+ * Binary container of tensor records, designed to be memory-mapped.
+ *
+ * File layout (native little-endian, every section 64-byte aligned):
+ *
+ *   [file header, 64 B] [record 0] [record 1] ... [index table]
+ *
+ * - File header: magic "INFTDS01", version, record count and the
+ *   offset of the index table.
+ * - Record: a 64-byte record header (dtype, layout, rank, payload size,
+ *   up to `kMaxRank` dimensions) followed by the payload, padded to a
+ *   multiple of 64 bytes.
+ * - Index table: one uint64 offset of each record header, in order.
+ *
+ * The index is written last, so a dataset can be produced in a single
+ * streaming pass; readers get O(1) random access through it.
+ */
+namespace dataset {
+
+inline constexpr size_t kAlignment = 64;
+inline constexpr uint32_t kMaxRank = 8;
+inline constexpr uint32_t kVersion = 1;
+
+} // namespace dataset
+
+/**
+ * Zero-copy view of one record of a mapped dataset.
+ *
+ * `bytes` points into the mapping and is 64-byte aligned; the view is
+ * valid as long as the `TensorDataset` it came from.
+ */
+struct TensorRecordView {
+  std::span<const uint8_t> bytes;
+  types::Shape shape;
+  types::Layout layout = types::Layout::UNDEFINED;
+  types::DataType dtype = types::DataType::UNDEFINED;
+
+  /**
+   * Payload as typed elements.
+   *
+   * Conventions:
+   * - Throws std::runtime_error if `dtype` is not FLOAT32.
+   *
+   * @return FLOAT32 elements
+   */
+  std::span<const float> floats() const;
+};
+
+/**
+ * Streaming writer of a tensor dataset.
+ *
+ * Conventions:
+ * - I/O failures and invalid records (rank above `kMaxRank`, payload
+ *   size not matching shape and dtype) throw; invalid records are
+ *   rejected before anything is written.
+ * - The file is complete only after an explicit `finish()`. A writer
+ *   destroyed before it (e.g. by an exception) leaves the header zeroed,
+ *   so `TensorDataset` refuses to open the partial file.
+ */
+class TensorDatasetWriter {
+public:
+  explicit TensorDatasetWriter(const std::string &path);
+  ~TensorDatasetWriter();
+
+  TensorDatasetWriter(const TensorDatasetWriter &) = delete;
+  TensorDatasetWriter &operator=(const TensorDatasetWriter &) = delete;
+
+  void append(std::span<const uint8_t> bytes, const types::Shape &shape, types::Layout layout,
+              types::DataType dtype);
+
+  void append(const types::Tensor &tensor) { append(tensor.buffer, tensor.shape, tensor.layout, tensor.dtype); }
+
+  /**
+   * Appends FLOAT32 data.
+   */
+  void append(std::span<const float> data, const types::Shape &shape,
+              types::Layout layout = types::Layout::UNDEFINED) {
+    append({reinterpret_cast<const uint8_t *>(data.data()), data.size_bytes()}, shape, layout,
+           types::DataType::FLOAT32);
+  }
+
+  /**
+   * Writes the index table and the final header.
+   */
+  void finish();
+
+  size_t size() const { return offsets_.size(); }
+
+private:
+  void pad();
+
+  std::ofstream out_;
+  uint64_t position_ = 0;
+  std::vector<uint64_t> offsets_;
+  bool finished_ = false;
+};
+
+/**
+ * Read-only, memory-mapped tensor dataset.
+ *
+ * Conventions:
+ * - The file and all record headers are validated on open; a malformed
+ *   or truncated file, or one whose records overlap or are not stored in
+ *   index order, throws std::runtime_error.
+ * - Records are returned as zero-copy views into the mapping, which is
+ *   shared, read-only and may be accessed from any thread.
+ */
+class TensorDataset {
+public:
+  explicit TensorDataset(const std::string &path);
+  ~TensorDataset();
+
+  TensorDataset(const TensorDataset &) = delete;
+  TensorDataset &operator=(const TensorDataset &) = delete;
+
+  size_t size() const { return count_; }
+
+  /**
+   * @param index Record index, throws std::out_of_range if not below `size()`
+   * @return Zero-copy record view
+   */
+  TensorRecordView record(size_t index) const;
+
+  /**
+   * Hints the kernel to read records [first, first + count) ahead of use
+   * (best effort, never fails).
+   */
+  void prefetch(size_t first, size_t count) const;
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t bytes_ = 0;
+  size_t count_ = 0;
+  const uint64_t *index_ = nullptr;
+};
+
+} // namespace inference::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+#include "inference/core/dtype.hpp"
+#include "inference/core/hash.hpp"
+#include "inference/core/shape.hpp"
+
+namespace inference::core {
+
+/**
+ * Identity of a tensor's contents for caching purposes.
+ *
+ * Two tensors with equal keys are treated as equal inputs: same
+ * content hash, same shape and same data type. The content hash is
+ * not verified byte-by-byte on lookup (collisions are assumed to be
+ * negligible for a 64-bit hash).
+ */
+struct TensorKey {
+  uint64_t hash = 0;
+  types::Shape shape;
+  types::DataType dtype = types::DataType::UNDEFINED;
+
+  bool operator==(const TensorKey &) const = default;
+};
+
+struct TensorKeyHash {
+  size_t operator()(const TensorKey &key) const {
+    uint64_t h = hash_combine(key.hash, static_cast<uint64_t>(key.dtype));
+    for (uint32_t dim : key.shape) {
+      h = hash_combine(h, dim);
+    }
+    return static_cast<size_t>(h);
+  }
+};
+
+/**
+ * Builds a cache key by hashing raw tensor bytes.
+ *
+ * @param data Pointer to tensor memory
+ * @param bytes Size of tensor memory in bytes
+ * @param shape Tensor shape
+ * @param dtype Tensor element type
+ * @return Tensor key
+ */
+inline TensorKey make_tensor_key(const void *data, size_t bytes, const types::Shape &shape, types::DataType dtype) {
+  return TensorKey{.hash = hash_bytes(data, bytes), .shape = shape, .dtype = dtype};
+}
+
+} // namespace inference::core
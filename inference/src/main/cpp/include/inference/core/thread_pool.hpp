@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace inference::core {
+
+/**
+ * Fixed-size pool of worker threads with a FIFO task queue.
+ *
+ * Conventions:
+ * - Tasks submitted before destruction are still executed; the
+ *   destructor waits for the queue to drain and joins all workers.
+ * - Exceptions thrown by a task are delivered through its future.
+ */
+class ThreadPool {
+public:
+  /**
+   * @param threads Number of workers; 0 selects the hardware concurrency
+   */
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t size() const { return workers_.size(); }
+
+  /**
+   * Queues a callable for execution on a worker.
+   *
+   * @param fn Callable taking no arguments
+   * @return Future for the callable's result
+   */
+  template <typename F> auto submit(F &&fn) -> std::future<std::invoke_result_t<F>> {
+    using Result = std::invoke_result_t<F>;
+
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+    auto future = task->get_future();
+    enqueue([task] { (*task)(); });
+    return future;
+  }
+
+  /**
+   * Splits [0, count) into contiguous chunks and runs `fn(begin, end)`
+   * on the workers and the calling thread, blocking until all chunks
+   * are done. The first exception (if any) is rethrown.
+   *
+   * Must not be called from one of this pool's workers.
+   *
+   * @param count Number of items
+   * @param min_chunk Smallest chunk worth handing to another thread
+   * @param fn Callable invoked with a half-open item range
+   */
+  void parallel_for(size_t count, size_t min_chunk, const std::function<void(size_t, size_t)> &fn);
+
+private:
+  void enqueue(std::function<void()> task);
+  void worker_loop();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace inference::core
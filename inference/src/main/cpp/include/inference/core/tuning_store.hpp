@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint> // uint32_t, uint64_t
+#include <optional>
+#include <string>
+
+namespace inference::core {
+
+/**
+ * Execution and batching parameters chosen by autotuning.
+ */
+struct TunedConfig {
+  uint32_t threads = 1;
+  uint32_t instances = 1;
+  uint32_t max_batch_size = 1;
+  uint64_t max_delay_us = 0;
+
+  bool operator==(const TunedConfig &) const = default;
+};
+
+/**
+ * Describes the CPU a tuning result was measured on.
+ *
+ * Combines the number of online cores with the maximum frequency of
+ * every core (where the kernel exposes it), so big.LITTLE layouts of
+ * equal core count are told apart.
+ *
+ * @return Stable, printable topology string, e.g. "8:1800000,...,2400000"
+ */
+std::string cpu_topology();
+
+/**
+ * Key of a tuning result: model content hash and CPU topology.
+ *
+ * @param model_hash Hash of the model bytes (see `hash_bytes`)
+ * @return Printable key without whitespace
+ */
+std::string tuning_key(uint64_t model_hash, const std::string &topology = cpu_topology());
+
+/**
+ * File-backed map of tuning keys to tuned configurations.
+ *
+ * One entry per line: `<key> <threads> <instances> <max_batch_size>
+ * <max_delay_us>`; malformed lines (including zero or negative counts)
+ * are ignored.
+ *
+ * Conventions:
+ * - A missing or unreadable file behaves like an empty store.
+ * - `save` replaces the file atomically (temporary file + rename) and
+ *   throws std::runtime_error on I/O failure; calls are serialized
+ *   within the process.
+ */
+class TuningStore {
+public:
+  explicit TuningStore(std::string path) : path_{std::move(path)} {}
+
+  std::optional<TunedConfig> load(const std::string &key) const;
+
+  void save(const std::string &key, const TunedConfig &config) const;
+
+  const std::string &path() const { return path_; }
+
+private:
+  std::string path_;
+};
+
+} // namespace inference::core
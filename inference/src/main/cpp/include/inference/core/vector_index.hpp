@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, int8_t
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "inference/core/dtype.hpp"
+#include "inference/core/thread_pool.hpp"
+
+namespace inference::core {
+
+/**
+ * Similarity measure used by a vector index.
+ *
+ * - COSINE: score is the cosine similarity, higher is closer.
+ * - L2: score is the Euclidean distance, lower is closer.
+ */
+enum class Metric : uint32_t {
+  COSINE = 0,
+  L2,
+};
+
+struct VectorIndexConfig {
+  /**
+   * Dimension of every stored and query vector.
+   */
+  uint32_t dim = 0;
+
+  Metric metric = Metric::COSINE;
+
+  /**
+   * Storage precision: FLOAT32, or INT8 for symmetric per-vector
+   * quantization (4x smaller, approximate scores).
+   */
+  types::DataType storage = types::DataType::FLOAT32;
+
+  /**
+   * Threads used by a single query (including the caller);
+   * 0 selects the hardware concurrency, 1 disables parallelism.
+   */
+  uint32_t threads = 1;
+};
+
+struct SearchResult {
+  uint32_t id = 0;
+  float score = 0.0F;
+};
+
+/**
+ * Flat (brute-force) nearest-neighbour index over fixed-size vectors.
+ *
+ * Vectors are stored row-major in one contiguous buffer and scored
+ * with SIMD dot products; both metrics reduce to a dot product (cosine
+ * over pre-normalized rows, L2 via |q|^2 + |v|^2 - 2 q.v).
+ *
+ * Conventions:
+ * - Ids are caller-chosen; adding an existing id replaces its vector.
+ * - Removal swaps the last row into the freed slot (order is not kept).
+ * - Queries may run concurrently; add/remove take an exclusive lock.
+ * - Dimension mismatches throw std::invalid_argument.
+ */
+class VectorIndex {
+public:
+  explicit VectorIndex(VectorIndexConfig config);
+  ~VectorIndex();
+
+  VectorIndex(const VectorIndex &) = delete;
+  VectorIndex &operator=(const VectorIndex &) = delete;
+
+  void add(uint32_t id, std::span<const float> vector);
+
+  /**
+   * @return true if the id was present
+   */
+  bool remove(uint32_t id);
+
+  size_t size() const;
+
+  const VectorIndexConfig &config() const { return config_; }
+
+  /**
+   * Returns up to `k` nearest vectors, best first.
+   *
+   * @param vector Query vector of `dim` elements
+   * @param k Maximum number of results
+   * @return Results, best match first (highest similarity, or lowest L2 distance)
+   */
+  std::vector<SearchResult> query(std::span<const float> vector, size_t k) const;
+
+private:
+  struct Prepared;
+
+  Prepared prepare(std::span<const float> vector) const;
+  void score_rows(const Prepared &query, size_t begin, size_t end, float *scores) const;
+
+  VectorIndexConfig config_;
+
+  mutable std::shared_mutex mutex_;
+  std::vector<float> rows_f32_;     // FLOAT32 storage
+  std::vector<int8_t> rows_i8_;     // INT8 storage
+  std::vector<float> scales_;       // INT8 dequantization scale per row
+  std::vector<float> norms_;        // squared L2 norm per row
+  std::vector<uint32_t> ids_;       // id per row
+  std::unordered_map<uint32_t, size_t> rows_by_id_;
+
+  std::unique_ptr<ThreadPool> pool_; // null when queries are single-threaded
+};
+
+} // namespace inference::core
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <vector>
+
+#include "inference/backend.hpp"
+
+// MindSpore Lite
+#include <mindspore/context.h>
+#include <mindspore/model.h>
+#include <mindspore/tensor.h>
+#include <mindspore/types.h>
+#include <mindspore/status.h>
+
+namespace inference {
+
+struct MSContext final {
+    OH_AI_ContextHandle handle{nullptr};
+
+    MSContext() {
+        handle = OH_AI_ContextCreate();
+        if (!handle) {
+            throw std::runtime_error("OH_AI_ContextCreate returned null");
+        }
+    }
+
+    ~MSContext() {
+        if (handle) {
+            OH_AI_ContextDestroy(&handle);
+        }
+    }
+};
+
+struct MSDeviceInfo final {
+    OH_AI_DeviceInfoHandle handle{nullptr};
+
+    explicit MSDeviceInfo(OH_AI_DeviceType type) {
+        handle = OH_AI_DeviceInfoCreate(type);
+
+        if (!handle) {
+            throw std::runtime_error("OH_AI_DeviceInfoCreate returned null");
+        }
+    }
+
+    ~MSDeviceInfo() {
+        if (handle) {
+//            OH_AI_DeviceInfoDestroy(&handle);
+        }
+    }
+};
+
+struct MSModel final {
+    OH_AI_ModelHandle handle{nullptr};
+
+    MSModel() {
+        handle = OH_AI_ModelCreate();
+        if (!handle) {
+            throw std::runtime_error("OH_AI_ModelCreate returned null");
+        }
+    }
+    ~MSModel() {
+        if (handle) {
+            OH_AI_ModelDestroy(&handle);
+        }
+    }
+};
+
+inline void check(OH_AI_Status status, const char *what) {
+    if (status != OH_AI_STATUS_SUCCESS) {
+        std::ostringstream os;
+        os << what << " failed, status=0x" << std::hex << static_cast<uint32_t>(status);
+        throw std::runtime_error(os.str());
+    }
+}
+
+inline std::string shape_to_string(const int64_t *shape, size_t num) {
+    std::ostringstream os;
+    os << "[";
+    for (size_t i = 0; i < num; i++) {
+        if (i) {
+            os << ", ";
+        }
+        os << shape[i];
+    }
+    os << "]";
+    return os.str();
+}
+
+inline void dump_tensor(OH_AI_TensorHandle tensor, const char *kind, size_t idx) {
+    const char *name = OH_AI_TensorGetName(tensor);
+    OH_AI_DataType data_type = OH_AI_TensorGetDataType(tensor);
+
+    size_t shape_num = 0;
+    const int64_t *shape = OH_AI_TensorGetShape(tensor, &shape_num);
+
+    size_t bytes = OH_AI_TensorGetDataSize(tensor);
+
+    std::ostringstream os;
+
+    os << kind << "[" << idx << "] "
+       << "name=" << (name ? name : "<null>") << " dtype=" << static_cast<int>(data_type)
+       << " shape=" << (shape ? shape_to_string(shape, shape_num) : "<null>") << " bytes=" << bytes;
+
+    auto str = os.str();
+
+    std::cerr << str << std::endl;
+}
+
+// MindSpore Lite CPU backend.
+//
+// The model is built once; predicts with a different batch size resize the
+// model input (the remaining dimensions must match the model).
+class MindSporeBackend final : public Backend {
+public:
+    explicit MindSporeBackend(const ModelConfig &config) : output_name_{config.output_name} {
+        const auto threads = std::max<std::uint32_t>(1, config.execution.threads);
+        OH_AI_ContextSetThreadNum(ctx_.handle, static_cast<int32_t>(threads));
+        OH_AI_ContextSetThreadAffinityMode(ctx_.handle, 0);
+        OH_AI_ContextAddDeviceInfo(ctx_.handle, cpu_device_.handle);
+
+        // build model from a file or from a raw buffer
+        if (!config.model_path.empty()) {
+            check(OH_AI_ModelBuildFromFile(model_.handle, config.model_path.c_str(), OH_AI_MODELTYPE_MINDIR,
+                                           ctx_.handle),
+                  "OH_AI_ModelBuildFromFile");
+        } else {
+            check(OH_AI_ModelBuild(model_.handle, config.model_data.data(), config.model_data.size(),
+                                   OH_AI_MODELTYPE_MINDIR, ctx_.handle),
+                  "OH_AI_ModelBuild");
+        }
+
+        // Fetch model inputs
+        auto inputs = OH_AI_ModelGetInputs(model_.handle);
+
+        if (inputs.handle_num != 1 || inputs.handle_list == nullptr) {
+            throw std::runtime_error("Expected exactly 1 input tensor");
+        }
+
+        // Validate dtype
+        const OH_AI_DataType dt = OH_AI_TensorGetDataType(inputs.handle_list[0]);
+        if (dt != OH_AI_DATATYPE_NUMBERTYPE_FLOAT32) {
+            throw std::runtime_error("Model input dtype is not float32");
+        }
+
+        // input shape as built (-1 = dynamic), resizes are validated against it
+        size_t rank = 0;
+        const int64_t *dims = OH_AI_TensorGetShape(inputs.handle_list[0], &rank);
+        if (dims) {
+            model_input_shape_.assign(dims, dims + rank);
+        }
+
+        // static input shape (batch dimension excluded), used e.g. for autotune inputs
+        if (dims && rank > 0 && std::all_of(dims + 1, dims + rank, [](int64_t dim) { return dim > 0; })) {
+            input_shape_.assign(1, 1);
+            for (size_t i = 1; i < rank; i++) {
+                input_shape_.push_back(static_cast<std::uint32_t>(dims[i]));
+            }
+        }
+
+        // Validate the requested named model output
+        if (!output_name_.empty() && !OH_AI_ModelGetOutputByTensorName(model_.handle, output_name_.c_str())) {
+            throw std::runtime_error("Model has no output tensor named '" + output_name_ + "'");
+        }
+    }
+
+    Tensor predict(const TensorView &in) override {
+        auto inputs = OH_AI_ModelGetInputs(model_.handle);
+        OH_AI_TensorHandle input0 = inputs.handle_list[0];
+
+        resize_if_needed(inputs, in.shape);
+
+        // Validate buffer sizes and copy input
+        const size_t expected_elems = static_cast<size_t>(OH_AI_TensorGetElementNum(input0));
+        if (in.data.size() != expected_elems) {
+            throw std::runtime_error("Input length mismatch (expected " + std::to_string(expected_elems) + " floats)");
+        }
+
+        void *dst = OH_AI_TensorGetMutableData(input0);
+        const size_t dst_bytes = OH_AI_TensorGetDataSize(input0);
+        if (!dst || dst_bytes != expected_elems * sizeof(float)) {
+            throw std::runtime_error("Input tensor buffer invalid size");
+        }
+
+        std::memcpy(dst, in.data.data(), dst_bytes);
+
+        // Predict
+        OH_AI_TensorHandleArray outputs{};
+        check(OH_AI_ModelPredict(model_.handle, inputs, &outputs, nullptr, nullptr), "OH_AI_ModelPredict");
+
+        if (!output_name_.empty()) {
+            OH_AI_TensorHandle named = OH_AI_ModelGetOutputByTensorName(model_.handle, output_name_.c_str());
+            if (!named) {
+                throw std::runtime_error("Model has no output tensor named '" + output_name_ + "'");
+            }
+            return copy_output(named);
+        }
+
+        if (outputs.handle_num != 1 || outputs.handle_list == nullptr) {
+            throw std::runtime_error("Expected exactly 1 output tensor");
+        }
+
+        return copy_output(outputs.handle_list[0]);
+    }
+
+    Shape input_shape() const override { return input_shape_; }
+
+private:
+    void resize_if_needed(const OH_AI_TensorHandleArray &inputs, const Shape &shape) {
+        if (model_input_shape_.size() != shape.size()) {
+            throw std::runtime_error("Model input shape mismatch");
+        }
+
+        // only the batch dimension (or dimensions that are dynamic in the built model) may change;
+        // checked against the original shape, since earlier resizes make dynamic dimensions concrete
+        for (size_t i = 1; i < shape.size(); i++) {
+            if (model_input_shape_[i] > 0 && model_input_shape_[i] != static_cast<int64_t>(shape[i])) {
+                throw std::runtime_error("Model input shape mismatch");
+            }
+        }
+
+        size_t shape_rank = 0;
+        const int64_t *shape_ptr = OH_AI_TensorGetShape(inputs.handle_list[0], &shape_rank);
+
+        const bool needs_resize = !shape_ptr || shape_rank != shape.size() ||
+                                  !std::equal(shape.begin(), shape.end(), shape_ptr, [](std::uint32_t a, int64_t b) {
+                                      return static_cast<int64_t>(a) == b;
+                                  });
+        if (!needs_resize) {
+            return;
+        }
+
+        OH_AI_ShapeInfo shape_info{};
+        if (shape.size() > std::size(shape_info.shape)) {
+            throw std::runtime_error("Model input rank too large");
+        }
+
+        shape_info.shape_num = shape.size();
+        for (size_t i = 0; i < shape.size(); i++) {
+            shape_info.shape[i] = shape[i];
+        }
+
+        check(OH_AI_ModelResize(model_.handle, inputs, &shape_info, 1), "OH_AI_ModelResize");
+    }
+
+    static Tensor copy_output(OH_AI_TensorHandle out0) {
+        if (OH_AI_TensorGetDataType(out0) != OH_AI_DATATYPE_NUMBERTYPE_FLOAT32) {
+            throw std::runtime_error("Model output dtype is not float32");
+        }
+
+        size_t shape_rank = 0;
+        const int64_t *shape_ptr = OH_AI_TensorGetShape(out0, &shape_rank);
+
+        // Read output and copy to our Tensor
+        const size_t out_bytes = OH_AI_TensorGetDataSize(out0);
+        const void *out_ptr = OH_AI_TensorGetData(out0);
+
+        if (!out_ptr || !shape_ptr || out_bytes % sizeof(float) != 0) {
+            throw std::runtime_error("Output tensor buffer invalid size");
+        }
+
+        Tensor out;
+        out.shape.assign(shape_ptr, shape_ptr + shape_rank);
+        out.data.resize(out_bytes / sizeof(float));
+        std::memcpy(out.data.data(), out_ptr, out_bytes);
+
+        return out;
+    }
+
+    std::string output_name_;
+    Shape input_shape_;
+    std::vector<int64_t> model_input_shape_;
+
+    // declaration order matters: the model is destroyed before its context
+    MSContext ctx_;
+    MSDeviceInfo cpu_device_{OH_AI_DEVICETYPE_CPU};
+    MSModel model_;
+};
+
+} // namespace inference
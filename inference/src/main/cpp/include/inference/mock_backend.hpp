@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "inference/backend.hpp"
+
+namespace inference {
+
+struct MockConfig final {
+    // number of output values per sample
+    std::uint32_t output_size{1000};
+    // synthetic cost of every predict call
+    std::chrono::microseconds predict_cost{0};
+    // additional synthetic cost per sample in a batch
+    std::chrono::microseconds sample_cost{0};
+    // simulated backend threads: the cost shrinks as (1 - p) + p / threads (Amdahl),
+    // with p = parallel_fraction
+    std::uint32_t threads{1};
+    double parallel_fraction{0.0};
+    // reported model input shape
+    Shape input_shape{};
+    // returned output, as ModelConfig::output_name: empty selects the default output, "embedding"
+    // the mock's one named output (output[n][j] = -(mean(input[n]) + j)); other names throw
+    std::string output_name{};
+};
+
+// Deterministic, model-free backend for host tests and load generation.
+//
+// For every sample n, output[n][j] = mean(input[n]) + j (negated for the named
+// output), so results can be checked per sample after batching. The synthetic cost is a busy-wait to
+// model a CPU-bound predict (it occupies a core like the real thing would).
+class MockBackend final : public Backend {
+public:
+    explicit MockBackend(MockConfig config = {}) : config_{std::move(config)} {
+        if (!config_.output_name.empty() && config_.output_name != "embedding") {
+            throw std::runtime_error("Model has no output tensor named '" + config_.output_name + "'");
+        }
+    }
+
+    Tensor predict(const TensorView &in) override {
+        const std::uint32_t batch = in.shape.empty() ? 1 : in.shape[0];
+
+        predict_calls_.fetch_add(1, std::memory_order_relaxed);
+        samples_.fetch_add(batch, std::memory_order_relaxed);
+
+        const double scale =
+            (1.0 - config_.parallel_fraction) + config_.parallel_fraction / std::max<std::uint32_t>(1, config_.threads);
+        spin_for(std::chrono::duration_cast<std::chrono::microseconds>(
+            (config_.predict_cost + config_.sample_cost * batch) * scale));
+
+        Tensor out;
+        out.shape = {batch, config_.output_size};
+        out.data.resize(static_cast<size_t>(batch) * config_.output_size);
+
+        const double sign = config_.output_name.empty() ? 1.0 : -1.0;
+        const size_t sample_size = batch > 0 ? in.data.size() / batch : 0;
+        for (std::uint32_t n = 0; n < batch; n++) {
+            double sum = 0.0;
+            for (size_t i = 0; i < sample_size; i++) {
+                sum += in.data[n * sample_size + i];
+            }
+            const double mean = sample_size > 0 ? sum / static_cast<double>(sample_size) : 0.0;
+
+            float *dst = out.data.data() + static_cast<size_t>(n) * config_.output_size;
+            for (std::uint32_t j = 0; j < config_.output_size; j++) {
+                dst[j] = static_cast<float>(sign * (mean + j));
+            }
+        }
+
+        return out;
+    }
+
+    Shape input_shape() const override { return config_.input_shape; }
+
+    std::uint64_t predict_calls() const { return predict_calls_.load(std::memory_order_relaxed); }
+
+    std::uint64_t samples() const { return samples_.load(std::memory_order_relaxed); }
+
+private:
+    static void spin_for(std::chrono::microseconds duration) {
+        if (duration.count() <= 0) {
+            return;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < deadline) {
+            // busy-wait
+        }
+    }
+
+    MockConfig config_;
+    std::atomic<std::uint64_t> predict_calls_{0};
+    std::atomic<std::uint64_t> samples_{0};
+};
+
+} // namespace inference
@@ -2,9 +2,19 @@
 
 #include "napi/native_api.h"
 
+#include "inference/autotune.hpp"
+#include "inference/batch_runner.hpp"
+#include "inference/pipeline.hpp"
 #include "inference/types.hpp"
+#include "inference/core/detection.hpp"
+#include "inference/core/lru_cache.hpp"
+#include "inference/core/vector_index.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace napi {
 
@@ -27,6 +37,57 @@ inline bool get_property(napi_env env, napi_value js_object, const char *name, n
     return napi_get_named_property(env, js_object, name, out) == napi_ok;
 }
 
+// true if the property exists and is not `undefined`
+inline bool get_optional_property(napi_env env, napi_value js_object, const char *name, napi_value *out) {
+    bool has = false;
+    if (napi_has_named_property(env, js_object, name, &has) != napi_ok || !has) {
+        return false;
+    }
+
+    napi_valuetype js_type = napi_undefined;
+    return get_property(env, js_object, name, out) && napi_typeof(env, *out, &js_type) == napi_ok &&
+           js_type != napi_undefined;
+}
+
+inline bool get_size(napi_env env, napi_value js_number, size_t &out) {
+    napi_valuetype js_type = napi_undefined;
+    if (napi_typeof(env, js_number, &js_type) != napi_ok || js_type != napi_number) {
+        return false;
+    }
+
+    int64_t value = 0;
+    if (napi_get_value_int64(env, js_number, &value) != napi_ok || value < 0) {
+        return false;
+    }
+
+    out = static_cast<size_t>(value);
+    return true;
+}
+
+inline bool get_number(napi_env env, napi_value js_number, double &out) {
+    napi_valuetype js_type = napi_undefined;
+    if (napi_typeof(env, js_number, &js_type) != napi_ok || js_type != napi_number) {
+        return false;
+    }
+
+    return napi_get_value_double(env, js_number, &out) == napi_ok;
+}
+
+inline bool get_bool(napi_env env, napi_value js_bool, bool &out) {
+    napi_valuetype js_type = napi_undefined;
+    if (napi_typeof(env, js_bool, &js_type) != napi_ok || js_type != napi_boolean) {
+        return false;
+    }
+
+    return napi_get_value_bool(env, js_bool, &out) == napi_ok;
+}
+
+inline void set_number(napi_env env, napi_value js_object, const char *name, double value) {
+    napi_value js_value{};
+    napi_create_double(env, value, &js_value);
+    napi_set_named_property(env, js_object, name, js_value);
+}
+
 inline bool get_string(napi_env env, napi_value js_string, std::string &out) {
     napi_valuetype js_type = napi_string;
     if (napi_typeof(env, js_string, &js_type) != napi_ok || js_type != napi_string) {
@@ -47,6 +108,31 @@ inline bool get_string(napi_env env, napi_value js_string, std::string &out) {
     return true;
 }
 
+inline bool get_float32_array(napi_env env, napi_value js_array, std::span<const float> &out) {
+    bool is_typed_array = false;
+    if (napi_is_typedarray(env, js_array, &is_typed_array) != napi_ok || !is_typed_array) {
+        return false;
+    }
+
+    napi_typedarray_type js_arr_type = napi_float32_array;
+    size_t length = 0; // bug: length could be the number of elements or bytes (need to work around using array buffer)
+    void *data = nullptr;
+    napi_value js_arr_buffer{};
+    size_t byte_offset = 0; // optional?
+
+    if (napi_get_typedarray_info(env, js_array, &js_arr_type, &length, &data, &js_arr_buffer, &byte_offset) != napi_ok) {
+        return false;
+    }
+
+    if (js_arr_type != napi_float32_array) {
+        return false;
+    }
+
+    // view of the actual length, not number of bytes
+    out = std::span<const float>{static_cast<const float *>(data), length / sizeof(float)};
+    return true;
+}
+
 inline bool parse_shape(napi_env env, napi_value js_shape, inference::Shape &shape, std::string &err) {
     // shape: Uint32Array
 
@@ -107,8 +193,275 @@ inline napi_value make_shape(napi_env env, const inference::Shape &shape) {
     return js_shape;
 }
 
-inline bool parse_model_config(napi_env env, napi_value js_config, inference::ModelConfig &config, std::string &err) {
-    // js_config: { device: string, modelData: ArrayBuffer }
+inline bool parse_detection_config(napi_env env, napi_value js_detection, inference::core::DetectionConfig &config,
+                                   std::string &err) {
+    // js_detection: see DetectionConfig in Index.d.ts
+    using inference::core::BoxDecoding;
+    using inference::core::BoxFormat;
+
+    napi_value js_value{};
+    size_t size = 0;
+
+    if (!get_property(env, js_detection, "numClasses", &js_value) || !get_size(env, js_value, size) || size == 0 ||
+        size > UINT32_MAX) {
+        err = "DetectionConfig.numClasses must be a positive number";
+        return false;
+    }
+    config.num_classes = static_cast<std::uint32_t>(size);
+
+    // row layout
+    if (get_optional_property(env, js_detection, "boxOffset", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "DetectionConfig.boxOffset must be a non-negative number";
+            return false;
+        }
+        config.box_offset = static_cast<std::uint32_t>(size);
+    }
+
+    if (get_optional_property(env, js_detection, "objectnessOffset", &js_value)) {
+        if (!get_size(env, js_value, size) || size > INT32_MAX) {
+            err = "DetectionConfig.objectnessOffset must be a non-negative number";
+            return false;
+        }
+        config.objectness_offset = static_cast<std::int32_t>(size);
+    }
+
+    if (get_optional_property(env, js_detection, "classOffset", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "DetectionConfig.classOffset must be a non-negative number";
+            return false;
+        }
+        config.class_offset = static_cast<std::uint32_t>(size);
+    }
+
+    std::string str;
+    if (get_optional_property(env, js_detection, "boxFormat", &js_value)) {
+        if (!get_string(env, js_value, str) || (str != "corners" && str != "center")) {
+            err = "DetectionConfig.boxFormat must be 'corners' or 'center'";
+            return false;
+        }
+        config.box_format = str == "corners" ? BoxFormat::CORNERS : BoxFormat::CENTER;
+    }
+
+    // decoding: anchors or grid (mutually exclusive)
+    std::span<const float> floats;
+    if (get_optional_property(env, js_detection, "anchors", &js_value)) {
+        if (!get_float32_array(env, js_value, floats)) {
+            err = "DetectionConfig.anchors must be a Float32Array";
+            return false;
+        }
+        config.decoding = BoxDecoding::ANCHORS;
+        config.anchors.assign(floats.begin(), floats.end());
+    }
+
+    if (get_optional_property(env, js_detection, "variances", &js_value)) {
+        if (!get_float32_array(env, js_value, floats) || floats.size() != config.variances.size()) {
+            err = "DetectionConfig.variances must be a Float32Array of 4 values";
+            return false;
+        }
+        std::copy(floats.begin(), floats.end(), config.variances.begin());
+    }
+
+    napi_value js_grid{};
+    if (get_optional_property(env, js_detection, "grid", &js_grid)) {
+        if (config.decoding == BoxDecoding::ANCHORS) {
+            err = "DetectionConfig cannot have both anchors and grid";
+            return false;
+        }
+
+        size_t width = 0;
+        size_t height = 0;
+        napi_value js_width{};
+        napi_value js_height{};
+        napi_value js_strides{};
+
+        if (!get_property(env, js_grid, "inputWidth", &js_width) || !get_size(env, js_width, width) ||
+            !get_property(env, js_grid, "inputHeight", &js_height) || !get_size(env, js_height, height) ||
+            width > UINT32_MAX || height > UINT32_MAX || !get_property(env, js_grid, "strides", &js_strides) ||
+            !parse_shape(env, js_strides, config.strides, err)) {
+            err = "DetectionConfig.grid must be { inputWidth: number, inputHeight: number, strides: Uint32Array }";
+            return false;
+        }
+
+        config.decoding = BoxDecoding::GRID;
+        config.input_width = static_cast<std::uint32_t>(width);
+        config.input_height = static_cast<std::uint32_t>(height);
+    }
+
+    // scoring and NMS
+    const struct {
+        const char *name;
+        bool *value;
+    } flags[] = {
+        {"sigmoid", &config.sigmoid},
+        {"multiLabel", &config.multi_label},
+        {"classAgnostic", &config.class_agnostic},
+    };
+
+    for (const auto &flag : flags) {
+        if (get_optional_property(env, js_detection, flag.name, &js_value) && !get_bool(env, js_value, *flag.value)) {
+            err = std::string{"DetectionConfig."} + flag.name + " must be a boolean";
+            return false;
+        }
+    }
+
+    double number = 0.0;
+    if (get_optional_property(env, js_detection, "scoreThreshold", &js_value)) {
+        if (!get_number(env, js_value, number)) {
+            err = "DetectionConfig.scoreThreshold must be a number";
+            return false;
+        }
+        config.score_threshold = static_cast<float>(number);
+    }
+
+    if (get_optional_property(env, js_detection, "iouThreshold", &js_value)) {
+        if (!get_number(env, js_value, number)) {
+            err = "DetectionConfig.iouThreshold must be a number";
+            return false;
+        }
+        config.iou_threshold = static_cast<float>(number);
+    }
+
+    if (get_optional_property(env, js_detection, "maxDetections", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "DetectionConfig.maxDetections must be a non-negative number";
+            return false;
+        }
+        config.max_detections = static_cast<std::uint32_t>(size);
+    }
+
+    if (get_optional_property(env, js_detection, "maxCandidates", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "DetectionConfig.maxCandidates must be a non-negative number";
+            return false;
+        }
+        config.max_candidates = static_cast<std::uint32_t>(size);
+    }
+
+    return true;
+}
+
+inline bool parse_tensor(napi_env env, napi_value js_tensor, inference::Tensor &tensor, std::string &err);
+
+inline bool get_uint32_list(napi_env env, napi_value js_array, std::vector<std::uint32_t> &out) {
+    // number[] of positive integers
+    bool is_array = false;
+    if (napi_is_array(env, js_array, &is_array) != napi_ok || !is_array) {
+        return false;
+    }
+
+    std::uint32_t length = 0;
+    napi_get_array_length(env, js_array, &length);
+
+    out.clear();
+    for (std::uint32_t i = 0; i < length; i++) {
+        napi_value js_value{};
+        size_t value = 0;
+        if (napi_get_element(env, js_array, i, &js_value) != napi_ok || !get_size(env, js_value, value) ||
+            value == 0 || value > UINT32_MAX) {
+            return false;
+        }
+        out.push_back(static_cast<std::uint32_t>(value));
+    }
+
+    return true;
+}
+
+inline bool parse_execution_config(napi_env env, napi_value js_config, inference::ExecutionConfig &config,
+                                   std::string &err) {
+    // js_config: { threads?: number, instances?: number }
+    const struct {
+        const char *name;
+        std::uint32_t *value;
+    } fields[] = {
+        {"threads", &config.threads},
+        {"instances", &config.instances},
+    };
+
+    napi_value js_value{};
+    size_t size = 0;
+
+    for (const auto &field : fields) {
+        if (!get_optional_property(env, js_config, field.name, &js_value)) {
+            continue;
+        }
+
+        if (!get_size(env, js_value, size) || size == 0 || size > UINT32_MAX) {
+            err = std::string{"ModelConfig.execution."} + field.name + " must be a positive number";
+            return false;
+        }
+        *field.value = static_cast<std::uint32_t>(size);
+    }
+
+    return true;
+}
+
+inline bool parse_autotune_config(napi_env env, napi_value js_config, inference::AutotuneConfig &config,
+                                  std::string &err) {
+    // js_config: { targetP99Ms: number, threads?: number[], instances?: number[], batchSizes?: number[],
+    //              concurrency?: number, requests?: number, warmup?: number, input?: InputTensor }
+    napi_value js_value{};
+
+    double target_ms = 0.0;
+    if (!get_property(env, js_config, "targetP99Ms", &js_value) || !get_number(env, js_value, target_ms) ||
+        !(target_ms > 0.0)) {
+        err = "AutotuneOptions.targetP99Ms must be a positive number";
+        return false;
+    }
+    config.target_p99 = std::chrono::microseconds{static_cast<int64_t>(target_ms * 1000.0)};
+
+    const struct {
+        const char *name;
+        std::vector<std::uint32_t> *values;
+    } lists[] = {
+        {"threads", &config.threads},
+        {"instances", &config.instances},
+        {"batchSizes", &config.batch_sizes},
+    };
+
+    for (const auto &list : lists) {
+        if (get_optional_property(env, js_config, list.name, &js_value) &&
+            !get_uint32_list(env, js_value, *list.values)) {
+            err = std::string{"AutotuneOptions."} + list.name + " must be an array of positive numbers";
+            return false;
+        }
+    }
+
+    const struct {
+        const char *name;
+        std::uint32_t *value;
+        bool positive;
+    } fields[] = {
+        {"concurrency", &config.concurrency, false},
+        {"requests", &config.requests, true},
+        {"warmup", &config.warmup, false},
+    };
+
+    size_t size = 0;
+    for (const auto &field : fields) {
+        if (!get_optional_property(env, js_config, field.name, &js_value)) {
+            continue;
+        }
+
+        if (!get_size(env, js_value, size) || size > UINT32_MAX || (field.positive && size == 0)) {
+            err = std::string{"AutotuneOptions."} + field.name + " must be a " +
+                  (field.positive ? "positive" : "non-negative") + " number";
+            return false;
+        }
+        *field.value = static_cast<std::uint32_t>(size);
+    }
+
+    if (get_optional_property(env, js_config, "input", &js_value) &&
+        !parse_tensor(env, js_value, config.input, err)) {
+        return false;
+    }
+
+    return true;
+}
+
+inline bool parse_model_config(napi_env env, napi_value js_config, inference::ModelConfig &config,
+                               napi_value *js_model_buffer, std::string &err) {
+    // js_config: { device: string, modelData: ArrayBuffer } or { device: string, modelPath: string }
 
     // device: string
     napi_value js_device{};
@@ -123,34 +476,120 @@ inline bool parse_model_config(napi_env env, napi_value js_config, inference::Mo
         return false;
     }
 
-    // modelData: ArrayBuffer (binary data)
-    napi_value js_model_data{};
-    if (!get_property(env, js_config, "modelData", &js_model_data)) {
-        err = "ModelConfig must have { modelData }";
+    // outputName (optional): string
+    napi_value js_output_name{};
+    if (get_optional_property(env, js_config, "outputName", &js_output_name) &&
+        !get_string(env, js_output_name, config.output_name)) {
+        err = "ModelConfig.outputName must be a string";
         return false;
     }
 
-    bool is_array_buffer = false;
-    if (napi_is_arraybuffer(env, js_model_data, &is_array_buffer) != napi_ok) {
+    // modelData: ArrayBuffer (binary data) or modelPath: string
+    // the buffer is not copied: callers must keep `js_model_buffer` referenced until the model is built
+    napi_value js_model_data{};
+    napi_value js_model_path{};
+    const bool has_data = get_optional_property(env, js_config, "modelData", &js_model_data);
+    const bool has_path = get_optional_property(env, js_config, "modelPath", &js_model_path);
+
+    if (has_data == has_path) {
+        err = "ModelConfig must have exactly one of { modelData, modelPath }";
         return false;
     }
 
-    if (!is_array_buffer) {
-        err = "ModelConfig.modelData must be an ArrayBuffer";
-        return false;
+    *js_model_buffer = nullptr;
+
+    if (has_path) {
+        if (!get_string(env, js_model_path, config.model_path) || config.model_path.empty()) {
+            err = "ModelConfig.modelPath must be a non-empty string";
+            return false;
+        }
+    } else {
+        bool is_array_buffer = false;
+        if (napi_is_arraybuffer(env, js_model_data, &is_array_buffer) != napi_ok || !is_array_buffer) {
+            err = "ModelConfig.modelData must be an ArrayBuffer";
+            return false;
+        }
+
+        void *data = nullptr;
+        size_t byte_length = 0;
+        if (napi_get_arraybuffer_info(env, js_model_data, &data, &byte_length) != napi_ok) {
+            err = "napi_get_arraybuffer_info failed";
+            return false;
+        }
+
+        config.model_data = std::span<const std::uint8_t>{static_cast<const std::uint8_t *>(data), byte_length};
+        *js_model_buffer = js_model_data;
     }
 
-    void *data = nullptr;
-    size_t byte_length = 0;
-    if (napi_get_arraybuffer_info(env, js_model_data, &data, &byte_length) != napi_ok) {
-        err = "napi_get_arraybuffer_info failed";
+    // cache (optional): { maxEntries?: number, maxBytes?: number }
+    napi_value js_cache{};
+    if (get_optional_property(env, js_config, "cache", &js_cache)) {
+        napi_value js_value{};
+
+        if (get_optional_property(env, js_cache, "maxEntries", &js_value) &&
+            !get_size(env, js_value, config.cache.max_entries)) {
+            err = "ModelConfig.cache.maxEntries must be a non-negative number";
+            return false;
+        }
+
+        if (get_optional_property(env, js_cache, "maxBytes", &js_value) &&
+            !get_size(env, js_value, config.cache.max_bytes)) {
+            err = "ModelConfig.cache.maxBytes must be a non-negative number";
+            return false;
+        }
+    }
+
+    // batching (optional): { maxBatchSize: number, maxDelayMs?: number }
+    napi_value js_batching{};
+    if (get_optional_property(env, js_config, "batching", &js_batching)) {
+        napi_value js_value{};
+        size_t max_batch_size = 0;
+
+        if (!get_property(env, js_batching, "maxBatchSize", &js_value) || !get_size(env, js_value, max_batch_size) ||
+            max_batch_size == 0 || max_batch_size > UINT32_MAX) {
+            err = "ModelConfig.batching.maxBatchSize must be a positive number";
+            return false;
+        }
+        config.batching.max_batch_size = static_cast<std::uint32_t>(max_batch_size);
+
+        if (get_optional_property(env, js_batching, "maxDelayMs", &js_value)) {
+            double max_delay_ms = 0.0;
+            if (!get_number(env, js_value, max_delay_ms) || !(max_delay_ms >= 0.0)) {
+                err = "ModelConfig.batching.maxDelayMs must be a non-negative number";
+                return false;
+            }
+            config.batching.max_delay = std::chrono::microseconds{static_cast<int64_t>(max_delay_ms * 1000.0)};
+        }
+    }
+
+    // detection (optional): postprocessing for detect()
+    napi_value js_detection{};
+    if (get_optional_property(env, js_config, "detection", &js_detection)) {
+        if (!parse_detection_config(env, js_detection, config.detection.emplace(), err)) {
+            return false;
+        }
+    }
+
+    // execution (optional): { threads?: number, instances?: number }
+    napi_value js_execution{};
+    if (get_optional_property(env, js_config, "execution", &js_execution) &&
+        !parse_execution_config(env, js_execution, config.execution, err)) {
         return false;
     }
 
-    config.model_data.resize(byte_length);
+    // autotune (optional): AutotuneOptions, run while loading
+    napi_value js_autotune{};
+    if (get_optional_property(env, js_config, "autotune", &js_autotune) &&
+        !parse_autotune_config(env, js_autotune, config.autotune.emplace(), err)) {
+        return false;
+    }
 
-    if (byte_length > 0) {
-        std::memcpy(config.model_data.data(), data, byte_length);
+    // tuningCache (optional): file of persisted autotune results
+    napi_value js_tuning_cache{};
+    if (get_optional_property(env, js_config, "tuningCache", &js_tuning_cache) &&
+        (!get_string(env, js_tuning_cache, config.tuning_path) || config.tuning_path.empty())) {
+        err = "ModelConfig.tuningCache must be a non-empty string";
+        return false;
     }
 
     return true;
@@ -177,36 +616,13 @@ inline bool parse_tensor(napi_env env, napi_value js_tensor, inference::Tensor &
         return false;
     }
 
-    bool is_typed_array = false;
-    if (napi_is_typedarray(env, js_data, &is_typed_array) != napi_ok) {
-        return false;
-    }
-
-    if (!is_typed_array) {
+    std::span<const float> data;
+    if (!get_float32_array(env, js_data, data)) {
         err = "InputTensor.data must be a Float32Array";
         return false;
     }
 
-    napi_typedarray_type js_arr_type = napi_float32_array;
-    size_t length = 0; // bug: length could be the number of elements or bytes (need to work around using array buffer)
-    void *data = nullptr;
-    napi_value js_arr_buffer{};
-    size_t byte_offset = 0; // optional?
-
-    if (napi_get_typedarray_info(env, js_data, &js_arr_type, &length, &data, &js_arr_buffer, &byte_offset) != napi_ok) {
-        return false;
-    }
-
-    if (js_arr_type != napi_float32_array) {
-        err = "InputTensor.data must be Float32Array";
-        return false;
-    }
-
-    tensor.data.resize(length / sizeof(float)); // resize to the actual length, not number of bytes
-
-    if (length > 0) {
-        std::memcpy(tensor.data.data(), data, length);
-    }
+    tensor.data.assign(data.begin(), data.end());
 
     return true;
 }
@@ -238,10 +654,301 @@ inline napi_value make_tensor(napi_env env, const inference::Tensor &tensor) {
     return js_tensor;
 }
 
-inline inference::TensorView as_view(const inference::Tensor &tensor) {
-    return {                       // clear structure creation (.field = data)
-            .shape = tensor.shape, // consider using view here
-            .data = std::span<const float>{tensor.data.data(), tensor.data.size()}};
+template <typename T>
+inline napi_value make_typed_array(napi_env env, napi_typedarray_type type, std::span<const T> values) {
+    const size_t bytes = values.size_bytes();
+
+    void *data = nullptr;
+    napi_value js_arr_buffer{};
+    if (napi_create_arraybuffer(env, bytes, &data, &js_arr_buffer) != napi_ok) {
+        return nullptr;
+    }
+
+    if (bytes > 0) {
+        std::memcpy(data, values.data(), bytes);
+    }
+
+    napi_value js_array{};
+    if (napi_create_typedarray(env, type, values.size(), js_arr_buffer, 0, &js_array) != napi_ok) {
+        return nullptr;
+    }
+
+    return js_array;
+}
+
+inline bool parse_vector_index_config(napi_env env, napi_value js_config, inference::core::VectorIndexConfig &config,
+                                      std::string &err) {
+    // js_config: { dim: number, metric?: 'cosine' | 'l2', storage?: 'float32' | 'int8', threads?: number }
+    using inference::core::Metric;
+    using inference::core::types::DataType;
+
+    napi_value js_value{};
+    size_t size = 0;
+
+    if (!get_property(env, js_config, "dim", &js_value) || !get_size(env, js_value, size) || size == 0 ||
+        size > UINT32_MAX) {
+        err = "VectorIndexConfig.dim must be a positive number";
+        return false;
+    }
+    config.dim = static_cast<std::uint32_t>(size);
+
+    std::string str;
+    if (get_optional_property(env, js_config, "metric", &js_value)) {
+        if (!get_string(env, js_value, str) || (str != "cosine" && str != "l2")) {
+            err = "VectorIndexConfig.metric must be 'cosine' or 'l2'";
+            return false;
+        }
+        config.metric = str == "cosine" ? Metric::COSINE : Metric::L2;
+    }
+
+    if (get_optional_property(env, js_config, "storage", &js_value)) {
+        if (!get_string(env, js_value, str) || (str != "float32" && str != "int8")) {
+            err = "VectorIndexConfig.storage must be 'float32' or 'int8'";
+            return false;
+        }
+        config.storage = str == "float32" ? DataType::FLOAT32 : DataType::INT8;
+    }
+
+    if (get_optional_property(env, js_config, "threads", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "VectorIndexConfig.threads must be a non-negative number";
+            return false;
+        }
+        config.threads = static_cast<std::uint32_t>(size);
+    }
+
+    return true;
+}
+
+inline bool parse_image_size(napi_env env, napi_value js_config, const char *name, std::uint32_t &width,
+                             std::uint32_t &height, std::string &err) {
+    // { width: number, height: number }
+    napi_value js_size{};
+    napi_value js_width{};
+    napi_value js_height{};
+    size_t w = 0;
+    size_t h = 0;
+
+    if (!get_property(env, js_config, name, &js_size) || !get_property(env, js_size, "width", &js_width) ||
+        !get_size(env, js_width, w) || !get_property(env, js_size, "height", &js_height) ||
+        !get_size(env, js_height, h) || w == 0 || h == 0 || w > UINT32_MAX || h > UINT32_MAX) {
+        err = std::string{"PipelineConfig."} + name + " must be { width: number, height: number } (positive)";
+        return false;
+    }
+
+    width = static_cast<std::uint32_t>(w);
+    height = static_cast<std::uint32_t>(h);
+    return true;
+}
+
+inline bool parse_normalization(napi_env env, napi_value js_config, const char *name,
+                                inference::core::Normalization &norm, std::string &err) {
+    // optional { mean: Float32Array, std: Float32Array }
+    napi_value js_norm{};
+    if (!get_optional_property(env, js_config, name, &js_norm)) {
+        return true;
+    }
+
+    napi_value js_mean{};
+    napi_value js_std{};
+    std::span<const float> mean;
+    std::span<const float> stddev;
+
+    if (!get_property(env, js_norm, "mean", &js_mean) || !get_float32_array(env, js_mean, mean) ||
+        !get_property(env, js_norm, "std", &js_std) || !get_float32_array(env, js_std, stddev)) {
+        err = std::string{"PipelineConfig."} + name + " must be { mean: Float32Array, std: Float32Array }";
+        return false;
+    }
+
+    if (std::find(stddev.begin(), stddev.end(), 0.0F) != stddev.end()) {
+        err = std::string{"PipelineConfig."} + name + ".std values must be non-zero";
+        return false;
+    }
+
+    norm.mean.assign(mean.begin(), mean.end());
+    norm.std.assign(stddev.begin(), stddev.end());
+    return true;
+}
+
+inline bool parse_pipeline_config(napi_env env, napi_value js_config, inference::PipelineConfig &config,
+                                  std::string &err) {
+    // js_config: see PipelineConfig in Index.d.ts (detector and classifier are unwrapped by the caller)
+    using inference::core::types::Layout;
+
+    napi_value js_value{};
+    size_t size = 0;
+
+    std::string str;
+    if (get_optional_property(env, js_config, "layout", &js_value)) {
+        if (!get_string(env, js_value, str) || (str != "NCHW" && str != "NHWC")) {
+            err = "PipelineConfig.layout must be 'NCHW' or 'NHWC'";
+            return false;
+        }
+        config.layout = str == "NCHW" ? Layout::NCHW : Layout::NHWC;
+    }
+
+    if (!parse_image_size(env, js_config, "detectorSize", config.detector_width, config.detector_height, err) ||
+        !parse_image_size(env, js_config, "cropSize", config.crop_width, config.crop_height, err) ||
+        !parse_normalization(env, js_config, "detectorNormalize", config.detector_norm, err) ||
+        !parse_normalization(env, js_config, "classifierNormalize", config.classifier_norm, err)) {
+        return false;
+    }
+
+    if (get_optional_property(env, js_config, "normalizedBoxes", &js_value) &&
+        !get_bool(env, js_value, config.normalized_boxes)) {
+        err = "PipelineConfig.normalizedBoxes must be a boolean";
+        return false;
+    }
+
+    if (get_optional_property(env, js_config, "maxCrops", &js_value)) {
+        if (!get_size(env, js_value, size) || size > UINT32_MAX) {
+            err = "PipelineConfig.maxCrops must be a non-negative number";
+            return false;
+        }
+        config.max_crops = static_cast<std::uint32_t>(size);
+    }
+
+    double number = 0.0;
+    if (get_optional_property(env, js_config, "cropPadding", &js_value)) {
+        if (!get_number(env, js_value, number) || number < 0.0) {
+            err = "PipelineConfig.cropPadding must be a non-negative number";
+            return false;
+        }
+        config.crop_padding = static_cast<float>(number);
+    }
+
+    return true;
+}
+
+inline bool parse_batch_runner_config(napi_env env, napi_value js_config, inference::BatchRunnerConfig &config,
+                                      std::string &err) {
+    // js_config: { batchSize?: number, workers?: number, prefetch?: number, topK?: number }
+    const struct {
+        const char *name;
+        std::uint32_t *value;
+        bool positive;
+    } fields[] = {
+        {"batchSize", &config.batch_size, true},
+        {"workers", &config.workers, true},
+        {"prefetch", &config.prefetch, false},
+        {"topK", &config.top_k, false},
+    };
+
+    napi_value js_value{};
+    size_t size = 0;
+
+    for (const auto &field : fields) {
+        if (!get_optional_property(env, js_config, field.name, &js_value)) {
+            continue;
+        }
+
+        if (!get_size(env, js_value, size) || size > UINT32_MAX || (field.positive && size == 0)) {
+            err = std::string{"DatasetRunOptions."} + field.name + " must be a " +
+                  (field.positive ? "positive" : "non-negative") + " number";
+            return false;
+        }
+        *field.value = static_cast<std::uint32_t>(size);
+    }
+
+    return true;
+}
+
+inline napi_value make_search_results(napi_env env, const std::vector<inference::core::SearchResult> &results) {
+    std::vector<std::uint32_t> ids(results.size());
+    std::vector<float> scores(results.size());
+
+    for (size_t i = 0; i < results.size(); i++) {
+        ids[i] = results[i].id;
+        scores[i] = results[i].score;
+    }
+
+    napi_value js_results{};
+    napi_create_object(env, &js_results);
+    napi_set_named_property(env, js_results, "ids",
+                            make_typed_array<std::uint32_t>(env, napi_uint32_array, ids));
+    napi_set_named_property(env, js_results, "scores", make_typed_array<float>(env, napi_float32_array, scores));
+
+    return js_results;
+}
+
+inline napi_value make_detections(napi_env env, const inference::core::Detections &detections) {
+    napi_value js_detections{};
+    napi_create_object(env, &js_detections);
+
+    napi_set_named_property(env, js_detections, "boxes",
+                            make_typed_array<float>(env, napi_float32_array, detections.boxes));
+    napi_set_named_property(env, js_detections, "scores",
+                            make_typed_array<float>(env, napi_float32_array, detections.scores));
+    napi_set_named_property(env, js_detections, "labels",
+                            make_typed_array<std::uint32_t>(env, napi_uint32_array, detections.labels));
+
+    return js_detections;
+}
+
+inline napi_value make_pipeline_result(napi_env env, const inference::PipelineResult &result) {
+    napi_value js_result = make_detections(env, result.detections);
+
+    napi_set_named_property(env, js_result, "classifications", make_tensor(env, result.classifications));
+    napi_set_named_property(env, js_result, "classLabels",
+                            make_typed_array<std::uint32_t>(env, napi_uint32_array, result.class_labels));
+    napi_set_named_property(env, js_result, "classScores",
+                            make_typed_array<float>(env, napi_float32_array, result.class_scores));
+
+    return js_result;
+}
+
+inline napi_value make_batch_runner_stats(napi_env env, const inference::BatchRunnerStats &stats) {
+    napi_value js_stats{};
+    napi_create_object(env, &js_stats);
+
+    set_number(env, js_stats, "records", static_cast<double>(stats.records));
+    set_number(env, js_stats, "batches", static_cast<double>(stats.batches));
+    set_number(env, js_stats, "seconds", stats.seconds);
+
+    return js_stats;
+}
+
+inline napi_value make_autotune_trial(napi_env env, const inference::AutotuneTrial &trial) {
+    napi_value js_trial{};
+    napi_create_object(env, &js_trial);
+
+    set_number(env, js_trial, "threads", trial.execution.threads);
+    set_number(env, js_trial, "instances", trial.execution.instances);
+    set_number(env, js_trial, "maxBatchSize", trial.batching.max_batch_size);
+    set_number(env, js_trial, "throughput", trial.throughput);
+    set_number(env, js_trial, "p99Ms", static_cast<double>(trial.p99_ns) / 1e6);
+
+    napi_value js_meets_slo{};
+    napi_get_boolean(env, trial.meets_slo, &js_meets_slo);
+    napi_set_named_property(env, js_trial, "meetsSlo", js_meets_slo);
+
+    return js_trial;
+}
+
+inline napi_value make_autotune_result(napi_env env, const inference::AutotuneResult &result) {
+    napi_value js_result = make_autotune_trial(env, result.best);
+
+    napi_value js_trials{};
+    napi_create_array_with_length(env, result.trials.size(), &js_trials);
+    for (size_t i = 0; i < result.trials.size(); i++) {
+        napi_set_element(env, js_trials, static_cast<std::uint32_t>(i), make_autotune_trial(env, result.trials[i]));
+    }
+    napi_set_named_property(env, js_result, "trials", js_trials);
+
+    return js_result;
+}
+
+inline napi_value make_cache_stats(napi_env env, const inference::core::CacheStats &stats) {
+    napi_value js_stats{};
+    napi_create_object(env, &js_stats);
+
+    set_number(env, js_stats, "hits", static_cast<double>(stats.hits));
+    set_number(env, js_stats, "misses", static_cast<double>(stats.misses));
+    set_number(env, js_stats, "evictions", static_cast<double>(stats.evictions));
+    set_number(env, js_stats, "entries", static_cast<double>(stats.entries));
+    set_number(env, js_stats, "bytes", static_cast<double>(stats.bytes));
+
+    return js_stats;
 }
 
 } // namespace napi
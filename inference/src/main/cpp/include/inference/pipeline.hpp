@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/context.hpp"
+#include "inference/types.hpp"
+#include "inference/core/detection.hpp"
+#include "inference/core/image.hpp"
+
+namespace inference {
+
+struct PipelineConfig final {
+    // layout of the pipeline input image and of both model inputs
+    core::types::Layout layout{core::types::Layout::NCHW};
+
+    // detector input size and normalization (the full image is resized to it)
+    std::uint32_t detector_width{0};
+    std::uint32_t detector_height{0};
+    core::Normalization detector_norm;
+    // detector boxes are relative [0, 1] instead of detector-input pixels
+    bool normalized_boxes{false};
+
+    // classifier input size and normalization (each box is cropped and resized to it)
+    std::uint32_t crop_width{0};
+    std::uint32_t crop_height{0};
+    core::Normalization classifier_norm;
+    // box enlargement on each side, relative to the box size
+    float crop_padding{0.0F};
+
+    // best detections that are classified (one classifier batch)
+    std::uint32_t max_crops{16};
+};
+
+struct PipelineResult final {
+    // detections in input image pixels, best first
+    core::Detections detections;
+    // classifier output, one row per detection: [K, ...]
+    Tensor classifications;
+    // argmax and max value of every classifier row
+    std::vector<std::uint32_t> class_labels;
+    std::vector<float> class_scores;
+};
+
+// Detector -> crop/resize/normalize -> batched classifier, without leaving native memory.
+//
+// The input image is taken once; the detector input and every crop are resampled
+// from it directly, and all crops are classified in a single batched run.
+class Pipeline final {
+public:
+    Pipeline(std::shared_ptr<Context> detector, std::shared_ptr<Context> classifier, PipelineConfig config)
+        : detector_{std::move(detector)}, classifier_{std::move(classifier)}, config_{std::move(config)} {
+        if (!detector_ || !classifier_) {
+            throw std::invalid_argument("Pipeline requires a detector and a classifier");
+        }
+
+        if (config_.detector_width == 0 || config_.detector_height == 0 || config_.crop_width == 0 ||
+            config_.crop_height == 0) {
+            throw std::invalid_argument("Pipeline input sizes must be positive");
+        }
+    }
+
+    PipelineResult run(const TensorView &in) {
+        const core::ImageView image = as_image(in);
+
+        // 1) detector on the resized full image
+        Tensor detector_input = resample(image, {0.0F, 0.0F, static_cast<float>(image.width),
+                                                 static_cast<float>(image.height)},
+                                         config_.detector_width, config_.detector_height, config_.detector_norm, 1);
+
+        PipelineResult result;
+        result.detections = detector_->detect(as_view(detector_input));
+
+        const size_t count = std::min<size_t>(result.detections.size(), config_.max_crops);
+        truncate(result.detections, count);
+        to_image_coordinates(result.detections, image);
+
+        if (count == 0) {
+            return result;
+        }
+
+        // 2) crops written straight into one classifier batch
+        const size_t crop_size = static_cast<size_t>(config_.crop_width) * config_.crop_height * image.channels;
+
+        Tensor batch;
+        batch.shape = input_shape(static_cast<std::uint32_t>(count), image.channels, config_.crop_width,
+                                  config_.crop_height);
+        batch.data.resize(count * crop_size);
+
+        for (size_t i = 0; i < count; i++) {
+            core::crop_resize_normalize(image, crop_roi(result.detections, i), config_.crop_width,
+                                        config_.crop_height, config_.layout, config_.classifier_norm,
+                                        batch.data.data() + i * crop_size);
+        }
+
+        // 3) batched classifier
+        result.classifications = classifier_->run(as_view(batch));
+
+        const size_t classes = result.classifications.data.size() / count;
+        if (classes == 0 || result.classifications.data.size() % count != 0) {
+            throw std::runtime_error("Classifier output does not match the number of crops");
+        }
+
+        result.class_labels.resize(count);
+        result.class_scores.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const auto first = result.classifications.data.begin() + static_cast<std::ptrdiff_t>(i * classes);
+            const auto best = std::max_element(first, first + static_cast<std::ptrdiff_t>(classes));
+            result.class_labels[i] = static_cast<std::uint32_t>(best - first);
+            result.class_scores[i] = *best;
+        }
+
+        return result;
+    }
+
+private:
+    core::ImageView as_image(const TensorView &in) const {
+        // [1, C, H, W] or [1, H, W, C]
+        if (in.shape.size() != 4 || in.shape[0] != 1) {
+            throw std::runtime_error("Pipeline input must be a single 4D image");
+        }
+
+        const bool planar = config_.layout == core::types::Layout::NCHW;
+        return core::ImageView{.data = in.data,
+                               .width = planar ? in.shape[3] : in.shape[2],
+                               .height = planar ? in.shape[2] : in.shape[1],
+                               .channels = planar ? in.shape[1] : in.shape[3],
+                               .layout = config_.layout};
+    }
+
+    Shape input_shape(std::uint32_t batch, std::uint32_t channels, std::uint32_t width, std::uint32_t height) const {
+        if (config_.layout == core::types::Layout::NCHW) {
+            return {batch, channels, height, width};
+        }
+        return {batch, height, width, channels};
+    }
+
+    Tensor resample(const core::ImageView &image, const core::Roi &roi, std::uint32_t width, std::uint32_t height,
+                    const core::Normalization &norm, std::uint32_t batch) const {
+        Tensor out;
+        out.shape = input_shape(batch, image.channels, width, height);
+        out.data.resize(static_cast<size_t>(width) * height * image.channels);
+        core::crop_resize_normalize(image, roi, width, height, config_.layout, norm, out.data.data());
+        return out;
+    }
+
+    static void truncate(core::Detections &detections, size_t count) {
+        detections.boxes.resize(count * 4);
+        detections.scores.resize(count);
+        detections.labels.resize(count);
+    }
+
+    void to_image_coordinates(core::Detections &detections, const core::ImageView &image) const {
+        const float sx = static_cast<float>(image.width) /
+                         (config_.normalized_boxes ? 1.0F : static_cast<float>(config_.detector_width));
+        const float sy = static_cast<float>(image.height) /
+                         (config_.normalized_boxes ? 1.0F : static_cast<float>(config_.detector_height));
+
+        for (size_t i = 0; i < detections.boxes.size(); i += 4) {
+            detections.boxes[i + 0] *= sx;
+            detections.boxes[i + 1] *= sy;
+            detections.boxes[i + 2] *= sx;
+            detections.boxes[i + 3] *= sy;
+        }
+    }
+
+    core::Roi crop_roi(const core::Detections &detections, size_t i) const {
+        const float *box = detections.boxes.data() + i * 4;
+        const float pad_x = (box[2] - box[0]) * config_.crop_padding;
+        const float pad_y = (box[3] - box[1]) * config_.crop_padding;
+        return {box[0] - pad_x, box[1] - pad_y, box[2] + pad_x, box[3] + pad_y};
+    }
+
+    std::shared_ptr<Context> detector_;
+    std::shared_ptr<Context> classifier_;
+    PipelineConfig config_;
+};
+
+} // namespace inference
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <span>
 #include <vector>
 #include <string>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+
+#include "inference/core/detection.hpp"
 
 namespace inference {
 
@@ -25,10 +30,72 @@ struct TensorView final {
     std::span<float const> data;
 };
 
+// view of an owning tensor, valid while `tensor` is alive and unchanged
+inline TensorView as_view(const Tensor &tensor) { return {.shape = tensor.shape, .data = tensor.data}; }
+
+// opt-in result cache (disabled while both budgets are 0)
+struct CacheConfig final {
+    std::size_t max_entries{0};
+    std::size_t max_bytes{0};
+
+    bool enabled() const { return max_entries != 0 || max_bytes != 0; }
+};
+
+// opt-in dynamic micro-batching of concurrent single-sample runs
+struct BatchingConfig final {
+    std::uint32_t max_batch_size{1};
+    // how long the first request of a batch may wait for others
+    std::chrono::microseconds max_delay{2000};
+
+    bool enabled() const { return max_batch_size > 1; }
+};
+
+// execution resources of a Context
+struct ExecutionConfig final {
+    // backend threads per instance (MindSpore Lite CPU threads)
+    std::uint32_t threads{1};
+    // backend instances predicting concurrently, each with its own copy of the model
+    std::uint32_t instances{1};
+};
+
+// self-tuning of execution and batching against a latency SLO (see autotune.hpp)
+struct AutotuneConfig final {
+    // p99 of run() that a configuration must meet
+    std::chrono::microseconds target_p99{0};
+    // candidates, empty selects defaults (threads: powers of two up to the core count,
+    // instances: 1 and 2, batch sizes: 1, 4 and 8); threads * instances never exceeds the cores
+    std::vector<std::uint32_t> threads;
+    std::vector<std::uint32_t> instances;
+    std::vector<std::uint32_t> batch_sizes;
+    // closed-loop clients while benchmarking, 0 = instances * batch size
+    std::uint32_t concurrency{0};
+    // runs per candidate (warmup runs are not measured)
+    std::uint32_t requests{200};
+    std::uint32_t warmup{20};
+    // benchmark input [1, ...], empty = zeros of the model input shape
+    Tensor input;
+};
+
 struct ModelConfig final {
     Device device;
-    // prototype: owning copy
-    std::vector<std::uint8_t> model_data;
+    // named model output returned by run(); empty selects the model's single output
+    std::string output_name;
+    CacheConfig cache;
+    BatchingConfig batching;
+    // detection postprocessing used by Context::detect()
+    std::optional<core::DetectionConfig> detection;
+    // model source, one of:
+    // - model_data: non-owning view (e.g. of a referenced JS ArrayBuffer), only read while the backend is built
+    // - model_path: model file, read by the backend
+    std::span<const std::uint8_t> model_data;
+    std::string model_path;
+    ExecutionConfig execution;
+    // tune execution and batching while loading (skipped if a tuned config was found in tuning_path)
+    std::optional<AutotuneConfig> autotune;
+    // file of persisted tuning results, keyed by model hash and CPU topology (empty = not persisted)
+    std::string tuning_path;
+    // key of this model in tuning_path, filled in while loading
+    std::string tuning_key;
 };
 
 } // namespace inference
@@ -1,28 +1,153 @@
 #include "napi/native_api.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <cstring>
+#include <string>
+#include <vector>
 
+#include "inference/autotune.hpp"
+#include "inference/batch_runner.hpp"
 #include "inference/context.hpp"
+#include "inference/mindspore_backend.hpp"
+#include "inference/mock_backend.hpp"
 #include "inference/napi_helpers.hpp"
+#include "inference/pipeline.hpp"
+#include "inference/core/thread_pool.hpp"
+#include "inference/core/tuning_store.hpp"
 
 namespace {
 
+inference::core::ThreadPool &loader_pool() {
+    // model builds are CPU-bound: one worker per core, independent of the shared async work pool
+    static inference::core::ThreadPool pool{0};
+    return pool;
+}
+
+std::unique_ptr<inference::Backend> make_backend(const inference::ModelConfig &config) {
+    if (config.device == "CPU") {
+        return std::make_unique<inference::MindSporeBackend>(config);
+    }
+
+    if (config.device == "MOCK") {
+        return std::make_unique<inference::MockBackend>(
+            inference::MockConfig{.threads = config.execution.threads, .output_name = config.output_name});
+    }
+
+    throw std::runtime_error("Unsupported device: " + config.device);
+}
+
+// persists an autotune result if the context was loaded with a tuning cache
+void save_tuning(const inference::ModelConfig &config, const inference::AutotuneTrial &best) {
+    if (!config.tuning_path.empty()) {
+        inference::core::TuningStore{config.tuning_path}.save(config.tuning_key, inference::to_tuned_config(best));
+    }
+}
+
+// Tunes and persists the result. Tuning runs are serialized process-wide: each candidate may use
+// every core, so concurrent runs (e.g. from a parallel createContexts) would skew each other's
+// measurements and persist a wrong best config for this CPU.
+inference::AutotuneResult autotune_and_save(inference::Context &context, const inference::AutotuneConfig &config) {
+    static std::mutex mutex;
+    std::scoped_lock lock{mutex};
+
+    auto result = inference::autotune(context, config);
+    save_tuning(context.config(), result.best);
+    return result;
+}
+
 struct ContextWrap final {
     std::shared_ptr<inference::Context> context;
     bool closed{false};
 };
 
-struct CreateCtxWork final {
+struct DetectWork final {
     napi_env env{};
     napi_deferred deferred{};
     napi_async_work work{};
 
-    inference::ModelConfig config;
     std::shared_ptr<inference::Context> context;
+    inference::Tensor input_owned; // safe: copied from JS
+    inference::core::Detections detections;
     std::string error;
 };
 
+struct VectorIndexWrap final {
+    std::shared_ptr<inference::core::VectorIndex> index;
+};
+
+struct QueryWork final {
+    napi_env env{};
+    napi_deferred deferred{};
+    napi_async_work work{};
+
+    std::shared_ptr<inference::core::VectorIndex> index;
+    std::vector<float> query; // safe: copied from JS
+    size_t k{0};
+    std::vector<inference::core::SearchResult> results;
+    std::string error;
+};
+
+struct DatasetWork final {
+    napi_env env{};
+    napi_deferred deferred{};
+    napi_async_work work{};
+
+    std::shared_ptr<inference::Context> context;
+    std::string input_path;
+    std::string output_path;
+    inference::BatchRunnerConfig config;
+    inference::BatchRunnerStats stats;
+    std::string error;
+};
+
+struct AutotuneWork final {
+    napi_env env{};
+    napi_deferred deferred{};
+    napi_async_work work{};
+
+    std::shared_ptr<inference::Context> context;
+    inference::AutotuneConfig config;
+    inference::AutotuneResult result;
+    std::string error;
+};
+
+struct PipelineWrap final {
+    std::shared_ptr<inference::Pipeline> pipeline;
+};
+
+struct PipelineWork final {
+    napi_env env{};
+    napi_deferred deferred{};
+    napi_async_work work{};
+
+    std::shared_ptr<inference::Pipeline> pipeline;
+    inference::Tensor input_owned; // safe: copied from JS
+    inference::PipelineResult result;
+    std::string error;
+};
+
+// Builds one or more contexts on the loader pool; results and progress reach JS via a threadsafe function.
+struct LoadWork final {
+    napi_env env{};
+    napi_deferred deferred{};
+    napi_threadsafe_function tsfn{};
+    bool single{false}; // createContext(): resolve with the context instead of an array
+
+    std::vector<inference::ModelConfig> configs;
+    std::vector<napi_ref> model_refs; // keep model ArrayBuffers alive (not copied) while loading
+    std::vector<std::shared_ptr<inference::Context>> contexts;
+    std::vector<std::string> errors;
+    // load events delivered or dropped (environment teardown); the last one frees the work
+    std::atomic<size_t> handled{0};
+};
+
+struct LoadEvent final {
+    LoadWork *work;
+    size_t index;
+};
+
 struct RunWork final {
     napi_env env{};
     napi_deferred deferred{};
@@ -34,10 +159,9 @@ struct RunWork final {
     std::string error;
 };
 
-napi_value ctx_run(napi_env env, napi_callback_info info) {
+// Unwraps `this` of an InferenceContext method; throws (returns null) if the context is closed.
+ContextWrap *unwrap_context(napi_env env, napi_callback_info info, size_t &argc, napi_value *args) {
     napi_value js_this{};
-    size_t argc = 1;
-    napi_value args[1]{};
 
     if (napi_get_cb_info(env, info, &argc, args, &js_this, nullptr) != napi_ok) {
         napi::throw_with_message(env, "failed napi_get_cb_info(...)");
@@ -55,6 +179,18 @@ napi_value ctx_run(napi_env env, napi_callback_info info) {
         return nullptr;
     }
 
+    return wrap;
+}
+
+napi_value ctx_run(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    auto *wrap = unwrap_context(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
     if (argc < 1) {
         napi::throw_with_message(env, "run(inputTensor) missing input");
         return nullptr;
@@ -81,7 +217,7 @@ napi_value ctx_run(napi_env env, napi_callback_info info) {
         [](napi_env /*env*/, void *data) {
             auto *work = static_cast<RunWork *>(data);
             try {
-                work->output_owned = work->context->run(napi::as_view(work->input_owned));
+                work->output_owned = work->context->run(inference::as_view(work->input_owned));
             } catch (const std::exception &e) {
                 work->error = e.what();
             }
@@ -102,6 +238,192 @@ napi_value ctx_run(napi_env env, napi_callback_info info) {
     return promise;
 }
 
+napi_value ctx_detect(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    auto *wrap = unwrap_context(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    if (argc < 1) {
+        napi::throw_with_message(env, "detect(inputTensor) missing input");
+        return nullptr;
+    }
+
+    auto *work = new DetectWork();
+    work->env = env;
+    work->context = wrap->context;
+
+    if (!napi::parse_tensor(env, args[0], work->input_owned, work->error)) {
+        napi::throw_with_message(env, work->error);
+        delete work;
+        return nullptr;
+    }
+
+    napi_value promise = nullptr;
+    napi_create_promise(env, &work->deferred, &promise);
+
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "inference.detect", NAPI_AUTO_LENGTH, &resource);
+
+    napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env /*env*/, void *data) {
+            auto *work = static_cast<DetectWork *>(data);
+            try {
+                work->detections = work->context->detect(inference::as_view(work->input_owned));
+            } catch (const std::exception &e) {
+                work->error = e.what();
+            }
+        },
+        [](napi_env env, napi_status /*status*/, void *data) {
+            std::unique_ptr<DetectWork> work(static_cast<DetectWork *>(data));
+            if (!work->error.empty()) {
+                napi_reject_deferred(env, work->deferred, napi::make_error(env, work->error));
+            } else {
+                napi_resolve_deferred(env, work->deferred, napi::make_detections(env, work->detections));
+            }
+            napi_delete_async_work(env, work->work);
+        },
+        work, &work->work);
+
+    napi_queue_async_work(env, work->work);
+    return promise;
+}
+
+napi_value ctx_cache_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 0;
+
+    auto *wrap = unwrap_context(env, info, argc, nullptr);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    return napi::make_cache_stats(env, wrap->context->cache_stats());
+}
+
+napi_value ctx_run_dataset(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3]{};
+
+    auto *wrap = unwrap_context(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    auto *work = new DatasetWork();
+    work->env = env;
+    work->context = wrap->context;
+
+    if (argc < 2 || !napi::get_string(env, args[0], work->input_path) ||
+        !napi::get_string(env, args[1], work->output_path)) {
+        napi::throw_with_message(env, "runDataset(inputPath, outputPath, options?) expects two paths");
+        delete work;
+        return nullptr;
+    }
+
+    // options (optional): object
+    napi_valuetype js_type = napi_undefined;
+    if (argc >= 3 && napi_typeof(env, args[2], &js_type) == napi_ok && js_type != napi_undefined &&
+        !napi::parse_batch_runner_config(env, args[2], work->config, work->error)) {
+        napi::throw_with_message(env, work->error);
+        delete work;
+        return nullptr;
+    }
+
+    napi_value promise = nullptr;
+    napi_create_promise(env, &work->deferred, &promise);
+
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "inference.runDataset", NAPI_AUTO_LENGTH, &resource);
+
+    napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env /*env*/, void *data) {
+            auto *work = static_cast<DatasetWork *>(data);
+            try {
+                const inference::core::TensorDataset input{work->input_path};
+                inference::core::TensorDatasetWriter output{work->output_path};
+
+                work->stats = inference::BatchRunner{*work->context, work->config}.run(input, output);
+                output.finish();
+            } catch (const std::exception &e) {
+                work->error = e.what();
+            }
+        },
+        [](napi_env env, napi_status /*status*/, void *data) {
+            std::unique_ptr<DatasetWork> work(static_cast<DatasetWork *>(data));
+            if (!work->error.empty()) {
+                napi_reject_deferred(env, work->deferred, napi::make_error(env, work->error));
+            } else {
+                napi_resolve_deferred(env, work->deferred, napi::make_batch_runner_stats(env, work->stats));
+            }
+            napi_delete_async_work(env, work->work);
+        },
+        work, &work->work);
+
+    napi_queue_async_work(env, work->work);
+    return promise;
+}
+
+napi_value ctx_autotune(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    auto *wrap = unwrap_context(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    if (argc < 1) {
+        napi::throw_with_message(env, "autotune(options) missing options");
+        return nullptr;
+    }
+
+    auto *work = new AutotuneWork();
+    work->env = env;
+    work->context = wrap->context;
+
+    if (!napi::parse_autotune_config(env, args[0], work->config, work->error)) {
+        napi::throw_with_message(env, work->error);
+        delete work;
+        return nullptr;
+    }
+
+    napi_value promise = nullptr;
+    napi_create_promise(env, &work->deferred, &promise);
+
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "inference.autotune", NAPI_AUTO_LENGTH, &resource);
+
+    napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env /*env*/, void *data) {
+            auto *work = static_cast<AutotuneWork *>(data);
+            try {
+                // the context keeps serving while candidates are benchmarked on temporary copies
+                work->result = autotune_and_save(*work->context, work->config);
+            } catch (const std::exception &e) {
+                work->error = e.what();
+            }
+        },
+        [](napi_env env, napi_status /*status*/, void *data) {
+            std::unique_ptr<AutotuneWork> work(static_cast<AutotuneWork *>(data));
+            if (!work->error.empty()) {
+                napi_reject_deferred(env, work->deferred, napi::make_error(env, work->error));
+            } else {
+                napi_resolve_deferred(env, work->deferred, napi::make_autotune_result(env, work->result));
+            }
+            napi_delete_async_work(env, work->work);
+        },
+        work, &work->work);
+
+    napi_queue_async_work(env, work->work);
+    return promise;
+}
+
 napi_value create_wrapped_context_object(napi_env env, std::shared_ptr<inference::Context> context) {
     napi_value obj = nullptr;
     napi_create_object(env, &obj);
@@ -113,31 +435,54 @@ napi_value create_wrapped_context_object(napi_env env, std::shared_ptr<inference
 
     napi_property_descriptor props[] = {
         {"run", nullptr, ctx_run, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"detect", nullptr, ctx_detect, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"cacheStats", nullptr, ctx_cache_stats, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"runDataset", nullptr, ctx_run_dataset, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"autotune", nullptr, ctx_autotune, nullptr, nullptr, nullptr, napi_default, nullptr},
     };
     napi_define_properties(env, obj, sizeof(props) / sizeof(props[0]), props);
     return obj;
 }
 
-} // namespace
+std::shared_ptr<inference::Context> context_property(napi_env env, napi_value js_config, const char *name) {
+    napi_value js_context{};
+    ContextWrap *wrap = nullptr;
 
-napi_value NAPI_Global_createContext(napi_env env, napi_callback_info info) {
+    if (!napi::get_property(env, js_config, name, &js_context) ||
+        napi_unwrap(env, js_context, reinterpret_cast<void **>(&wrap)) != napi_ok || !wrap || wrap->closed ||
+        !wrap->context) {
+        return nullptr;
+    }
+
+    return wrap->context;
+}
+
+napi_value pipeline_run(napi_env env, napi_callback_info info) {
+    napi_value js_this{};
     size_t argc = 1;
     napi_value args[1]{};
 
-    if (napi_get_cb_info(env, info, &argc, args, nullptr, nullptr) != napi_ok) {
+    if (napi_get_cb_info(env, info, &argc, args, &js_this, nullptr) != napi_ok) {
         napi::throw_with_message(env, "failed napi_get_cb_info(...)");
         return nullptr;
     }
 
+    PipelineWrap *wrap = nullptr;
+    if (napi_unwrap(env, js_this, reinterpret_cast<void **>(&wrap)) != napi_ok || !wrap || !wrap->pipeline) {
+        napi::throw_with_message(env, "failed napi_unwrap(...) on Pipeline");
+        return nullptr;
+    }
+
     if (argc < 1) {
-        napi::throw_with_message(env, "createContext(config) missing config");
+        napi::throw_with_message(env, "run(image) missing input");
         return nullptr;
     }
 
-    auto *work = new CreateCtxWork();
+    auto *work = new PipelineWork();
     work->env = env;
+    work->pipeline = wrap->pipeline;
 
-    if (!napi::parse_model_config(env, args[0], work->config, work->error)) {
+    if (!napi::parse_tensor(env, args[0], work->input_owned, work->error)) {
         napi::throw_with_message(env, work->error);
         delete work;
         return nullptr;
@@ -147,26 +492,163 @@ napi_value NAPI_Global_createContext(napi_env env, napi_callback_info info) {
     napi_create_promise(env, &work->deferred, &promise);
 
     napi_value resource = nullptr;
-    napi_create_string_utf8(env, "inference.createContext", NAPI_AUTO_LENGTH, &resource);
+    napi_create_string_utf8(env, "inference.pipeline", NAPI_AUTO_LENGTH, &resource);
 
     napi_create_async_work(
         env, nullptr, resource,
         [](napi_env /*env*/, void *data) {
-            auto *w = static_cast<CreateCtxWork *>(data);
+            auto *work = static_cast<PipelineWork *>(data);
             try {
-                w->context = std::make_shared<inference::Context>(std::move(w->config));
+                work->result = work->pipeline->run(inference::as_view(work->input_owned));
             } catch (const std::exception &e) {
-                w->error = e.what();
+                work->error = e.what();
             }
         },
         [](napi_env env, napi_status /*status*/, void *data) {
-            std::unique_ptr<CreateCtxWork> work(static_cast<CreateCtxWork *>(data));
+            std::unique_ptr<PipelineWork> work(static_cast<PipelineWork *>(data));
+            if (!work->error.empty()) {
+                napi_reject_deferred(env, work->deferred, napi::make_error(env, work->error));
+            } else {
+                napi_resolve_deferred(env, work->deferred, napi::make_pipeline_result(env, work->result));
+            }
+            napi_delete_async_work(env, work->work);
+        },
+        work, &work->work);
+
+    napi_queue_async_work(env, work->work);
+    return promise;
+}
+
+VectorIndexWrap *unwrap_index(napi_env env, napi_callback_info info, size_t &argc, napi_value *args) {
+    napi_value js_this{};
+
+    if (napi_get_cb_info(env, info, &argc, args, &js_this, nullptr) != napi_ok) {
+        napi::throw_with_message(env, "failed napi_get_cb_info(...)");
+        return nullptr;
+    }
+
+    VectorIndexWrap *wrap = nullptr;
+    if (napi_unwrap(env, js_this, reinterpret_cast<void **>(&wrap)) != napi_ok || !wrap || !wrap->index) {
+        napi::throw_with_message(env, "failed napi_unwrap(...) on VectorIndex");
+        return nullptr;
+    }
+
+    return wrap;
+}
+
+bool parse_vector_id(napi_env env, napi_value js_id, std::uint32_t &id) {
+    size_t value = 0;
+    if (!napi::get_size(env, js_id, value) || value > UINT32_MAX) {
+        return false;
+    }
+    id = static_cast<std::uint32_t>(value);
+    return true;
+}
+
+napi_value index_add(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2]{};
+
+    auto *wrap = unwrap_index(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    std::uint32_t id = 0;
+    std::span<const float> vector;
+
+    if (argc < 2 || !parse_vector_id(env, args[0], id) || !napi::get_float32_array(env, args[1], vector)) {
+        napi::throw_with_message(env, "add(id: number, vector: Float32Array) invalid arguments");
+        return nullptr;
+    }
+
+    try {
+        wrap->index->add(id, vector);
+    } catch (const std::exception &e) {
+        napi::throw_with_message(env, e.what());
+    }
+
+    return nullptr;
+}
+
+napi_value index_remove(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    auto *wrap = unwrap_index(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    std::uint32_t id = 0;
+    if (argc < 1 || !parse_vector_id(env, args[0], id)) {
+        napi::throw_with_message(env, "remove(id: number) invalid arguments");
+        return nullptr;
+    }
+
+    napi_value removed{};
+    napi_get_boolean(env, wrap->index->remove(id), &removed);
+    return removed;
+}
+
+napi_value index_size(napi_env env, napi_callback_info info) {
+    size_t argc = 0;
+
+    auto *wrap = unwrap_index(env, info, argc, nullptr);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    napi_value size{};
+    napi_create_double(env, static_cast<double>(wrap->index->size()), &size);
+    return size;
+}
+
+napi_value index_query(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2]{};
+
+    auto *wrap = unwrap_index(env, info, argc, args);
+    if (!wrap) {
+        return nullptr;
+    }
+
+    std::span<const float> vector;
+    size_t k = 0;
+
+    if (argc < 2 || !napi::get_float32_array(env, args[0], vector) || !napi::get_size(env, args[1], k)) {
+        napi::throw_with_message(env, "query(vector: Float32Array, k: number) invalid arguments");
+        return nullptr;
+    }
+
+    auto *work = new QueryWork();
+    work->env = env;
+    work->index = wrap->index;
+    work->query.assign(vector.begin(), vector.end());
+    work->k = k;
+
+    napi_value promise = nullptr;
+    napi_create_promise(env, &work->deferred, &promise);
 
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "inference.query", NAPI_AUTO_LENGTH, &resource);
+
+    napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env /*env*/, void *data) {
+            auto *work = static_cast<QueryWork *>(data);
+            try {
+                work->results = work->index->query(work->query, work->k);
+            } catch (const std::exception &e) {
+                work->error = e.what();
+            }
+        },
+        [](napi_env env, napi_status /*status*/, void *data) {
+            std::unique_ptr<QueryWork> work(static_cast<QueryWork *>(data));
             if (!work->error.empty()) {
                 napi_reject_deferred(env, work->deferred, napi::make_error(env, work->error));
             } else {
-                napi_value ctx_obj = create_wrapped_context_object(env, work->context);
-                napi_resolve_deferred(env, work->deferred, ctx_obj);
+                napi_resolve_deferred(env, work->deferred, napi::make_search_results(env, work->results));
             }
             napi_delete_async_work(env, work->work);
         },
@@ -176,10 +658,367 @@ napi_value NAPI_Global_createContext(napi_env env, napi_callback_info info) {
     return promise;
 }
 
+std::shared_ptr<inference::Context> build_context(inference::ModelConfig config) {
+    // a persisted tuning result for this model and CPU replaces the configured execution and batching
+    bool tuned = false;
+    if (!config.tuning_path.empty()) {
+        config.tuning_key = inference::core::tuning_key(inference::model_hash(config));
+        if (const auto stored = inference::core::TuningStore{config.tuning_path}.load(config.tuning_key)) {
+            inference::apply_tuned_config(*stored, config);
+            tuned = true;
+        }
+    }
+
+    // the referenced buffer is released once loading completes; contexts that expect to be
+    // autotuned keep their own copy so backends can be rebuilt with other settings
+    const bool from_buffer = !config.model_data.empty();
+    std::shared_ptr<const std::vector<std::uint8_t>> model_copy;
+    if (from_buffer && (config.autotune || !config.tuning_path.empty())) {
+        model_copy =
+            std::make_shared<const std::vector<std::uint8_t>>(config.model_data.begin(), config.model_data.end());
+    }
+
+    auto factory = [from_buffer, model_copy](const inference::ModelConfig &model) {
+        if (!model_copy) {
+            if (from_buffer && model.model_data.empty()) {
+                throw std::runtime_error("Model loaded from modelData cannot be rebuilt: "
+                                         "create the context with autotune or tuningCache, or use modelPath");
+            }
+            return make_backend(model);
+        }
+
+        inference::ModelConfig owned = model;
+        owned.model_data = *model_copy;
+        return make_backend(owned);
+    };
+
+    auto context = std::make_shared<inference::Context>(config, std::move(factory));
+
+    if (config.autotune && !tuned) {
+        autotune_and_save(*context, *config.autotune);
+    }
+
+    return context;
+}
+
+void finish_load(napi_env env, LoadWork *work) {
+    std::unique_ptr<LoadWork> owned{work};
+
+    for (napi_ref ref : work->model_refs) {
+        if (ref) {
+            napi_delete_reference(env, ref);
+        }
+    }
+
+    std::string error;
+    for (size_t i = 0; i < work->errors.size(); i++) {
+        if (!work->errors[i].empty()) {
+            error += (error.empty() ? "" : "; ") + std::string{"model "} + std::to_string(i) + ": " + work->errors[i];
+        }
+    }
+
+    if (!error.empty()) {
+        napi_reject_deferred(env, work->deferred, napi::make_error(env, work->single ? work->errors[0] : error));
+    } else if (work->single) {
+        napi_resolve_deferred(env, work->deferred, create_wrapped_context_object(env, work->contexts[0]));
+    } else {
+        napi_value js_contexts{};
+        napi_create_array_with_length(env, work->contexts.size(), &js_contexts);
+        for (size_t i = 0; i < work->contexts.size(); i++) {
+            napi_set_element(env, js_contexts, static_cast<uint32_t>(i),
+                             create_wrapped_context_object(env, work->contexts[i]));
+        }
+        napi_resolve_deferred(env, work->deferred, js_contexts);
+    }
+
+    napi_release_threadsafe_function(work->tsfn, napi_tsfn_release);
+}
+
+// JS thread: reports progress for one finished model, settles the promise after the last one
+void on_load_event(napi_env env, napi_value js_callback, void * /*context*/, void *data) {
+    std::unique_ptr<LoadEvent> event{static_cast<LoadEvent *>(data)};
+    LoadWork *work = event->work;
+
+    const size_t handled = work->handled.fetch_add(1) + 1;
+
+    if (!env) {
+        // environment is shutting down: its refs and deferred go with it, only native state is freed
+        if (handled == work->configs.size()) {
+            delete work;
+        }
+        return;
+    }
+
+    if (js_callback) {
+        napi_value js_progress{};
+        napi_create_object(env, &js_progress);
+        napi::set_number(env, js_progress, "index", static_cast<double>(event->index));
+        napi::set_number(env, js_progress, "loaded", static_cast<double>(handled));
+        napi::set_number(env, js_progress, "total", static_cast<double>(work->configs.size()));
+
+        if (!work->errors[event->index].empty()) {
+            napi_value js_error{};
+            napi_create_string_utf8(env, work->errors[event->index].c_str(), NAPI_AUTO_LENGTH, &js_error);
+            napi_set_named_property(env, js_progress, "error", js_error);
+        }
+
+        napi_value js_undefined{};
+        napi_get_undefined(env, &js_undefined);
+        napi_call_function(env, js_undefined, js_callback, 1, &js_progress, nullptr);
+    }
+
+    // events may arrive in any order; the promise settles after the last one
+    if (handled == work->configs.size()) {
+        finish_load(env, work);
+    }
+}
+
+// Parses configs on the JS thread (no model copies) and queues one build per model on the loader pool.
+napi_value start_load(napi_env env, std::vector<napi_value> js_configs, napi_value js_progress, bool single) {
+    auto work = std::make_unique<LoadWork>();
+    work->env = env;
+    work->single = single;
+
+    const size_t total = js_configs.size();
+    work->configs.resize(total);
+    work->model_refs.resize(total, nullptr);
+    work->contexts.resize(total);
+    work->errors.resize(total);
+
+    std::string error;
+    for (size_t i = 0; i < total; i++) {
+        napi_value js_model_buffer{};
+        if (!napi::parse_model_config(env, js_configs[i], work->configs[i], &js_model_buffer, error)) {
+            for (napi_ref ref : work->model_refs) {
+                if (ref) {
+                    napi_delete_reference(env, ref);
+                }
+            }
+            napi::throw_with_message(env, single ? error : "config " + std::to_string(i) + ": " + error);
+            return nullptr;
+        }
+
+        if (js_model_buffer) {
+            napi_create_reference(env, js_model_buffer, 1, &work->model_refs[i]);
+        }
+    }
+
+    napi_value promise = nullptr;
+    napi_create_promise(env, &work->deferred, &promise);
+
+    if (total == 0) {
+        napi_value js_contexts{};
+        napi_create_array_with_length(env, 0, &js_contexts);
+        napi_resolve_deferred(env, work->deferred, js_contexts);
+        return promise;
+    }
+
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, single ? "inference.createContext" : "inference.createContexts", NAPI_AUTO_LENGTH,
+                            &resource);
+
+    if (napi_create_threadsafe_function(env, js_progress, nullptr, resource, 0, 1, nullptr, nullptr, nullptr,
+                                        on_load_event, &work->tsfn) != napi_ok) {
+        napi_reject_deferred(env, work->deferred, napi::make_error(env, "napi_create_threadsafe_function failed"));
+        for (napi_ref ref : work->model_refs) {
+            if (ref) {
+                napi_delete_reference(env, ref);
+            }
+        }
+        return promise;
+    }
+
+    LoadWork *shared = work.release(); // owned by the last load event (see finish_load)
+
+    for (size_t i = 0; i < total; i++) {
+        loader_pool().submit([shared, i] {
+            try {
+                shared->contexts[i] = build_context(std::move(shared->configs[i]));
+            } catch (const std::exception &e) {
+                shared->errors[i] = e.what();
+            }
+            auto *event = new LoadEvent{shared, i};
+            if (napi_call_threadsafe_function(shared->tsfn, event, napi_tsfn_blocking) != napi_ok) {
+                // closing: the event never reaches on_load_event, account for it here
+                delete event;
+                if (shared->handled.fetch_add(1) + 1 == shared->configs.size()) {
+                    delete shared;
+                }
+            }
+        });
+    }
+
+    return promise;
+}
+
+} // namespace
+
+napi_value NAPI_Global_createVectorIndex(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    if (napi_get_cb_info(env, info, &argc, args, nullptr, nullptr) != napi_ok) {
+        napi::throw_with_message(env, "failed napi_get_cb_info(...)");
+        return nullptr;
+    }
+
+    if (argc < 1) {
+        napi::throw_with_message(env, "createVectorIndex(config) missing config");
+        return nullptr;
+    }
+
+    inference::core::VectorIndexConfig config;
+    std::string error;
+
+    if (!napi::parse_vector_index_config(env, args[0], config, error)) {
+        napi::throw_with_message(env, error);
+        return nullptr;
+    }
+
+    std::shared_ptr<inference::core::VectorIndex> index;
+    try {
+        index = std::make_shared<inference::core::VectorIndex>(config);
+    } catch (const std::exception &e) {
+        napi::throw_with_message(env, e.what());
+        return nullptr;
+    }
+
+    napi_value obj = nullptr;
+    napi_create_object(env, &obj);
+
+    auto *wrap = new VectorIndexWrap{std::move(index)};
+    napi_wrap(
+        env, obj, wrap,
+        [](napi_env /*env*/, void *data, void * /*hint*/) { delete static_cast<VectorIndexWrap *>(data); }, nullptr,
+        nullptr);
+
+    napi_property_descriptor props[] = {
+        {"add", nullptr, index_add, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"remove", nullptr, index_remove, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"size", nullptr, index_size, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"query", nullptr, index_query, nullptr, nullptr, nullptr, napi_default, nullptr},
+    };
+    napi_define_properties(env, obj, sizeof(props) / sizeof(props[0]), props);
+    return obj;
+}
+
+napi_value NAPI_Global_createPipeline(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    if (napi_get_cb_info(env, info, &argc, args, nullptr, nullptr) != napi_ok) {
+        napi::throw_with_message(env, "failed napi_get_cb_info(...)");
+        return nullptr;
+    }
+
+    if (argc < 1) {
+        napi::throw_with_message(env, "createPipeline(config) missing config");
+        return nullptr;
+    }
+
+    auto detector = context_property(env, args[0], "detector");
+    auto classifier = context_property(env, args[0], "classifier");
+    if (!detector || !classifier) {
+        napi::throw_with_message(env, "PipelineConfig must have open { detector, classifier } contexts");
+        return nullptr;
+    }
+
+    inference::PipelineConfig config;
+    std::string error;
+
+    if (!napi::parse_pipeline_config(env, args[0], config, error)) {
+        napi::throw_with_message(env, error);
+        return nullptr;
+    }
+
+    std::shared_ptr<inference::Pipeline> pipeline;
+    try {
+        pipeline = std::make_shared<inference::Pipeline>(std::move(detector), std::move(classifier), std::move(config));
+    } catch (const std::exception &e) {
+        napi::throw_with_message(env, e.what());
+        return nullptr;
+    }
+
+    napi_value obj = nullptr;
+    napi_create_object(env, &obj);
+
+    auto *wrap = new PipelineWrap{std::move(pipeline)};
+    napi_wrap(
+        env, obj, wrap, [](napi_env /*env*/, void *data, void * /*hint*/) { delete static_cast<PipelineWrap *>(data); },
+        nullptr, nullptr);
+
+    napi_property_descriptor props[] = {
+        {"run", nullptr, pipeline_run, nullptr, nullptr, nullptr, napi_default, nullptr},
+    };
+    napi_define_properties(env, obj, sizeof(props) / sizeof(props[0]), props);
+    return obj;
+}
+
+napi_value NAPI_Global_createContext(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1]{};
+
+    if (napi_get_cb_info(env, info, &argc, args, nullptr, nullptr) != napi_ok) {
+        napi::throw_with_message(env, "failed napi_get_cb_info(...)");
+        return nullptr;
+    }
+
+    if (argc < 1) {
+        napi::throw_with_message(env, "createContext(config) missing config");
+        return nullptr;
+    }
+
+    return start_load(env, {args[0]}, nullptr, true);
+}
+
+napi_value NAPI_Global_createContexts(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2]{};
+
+    if (napi_get_cb_info(env, info, &argc, args, nullptr, nullptr) != napi_ok) {
+        napi::throw_with_message(env, "failed napi_get_cb_info(...)");
+        return nullptr;
+    }
+
+    bool is_array = false;
+    if (argc < 1 || napi_is_array(env, args[0], &is_array) != napi_ok || !is_array) {
+        napi::throw_with_message(env, "createContexts(configs) expects an array of configs");
+        return nullptr;
+    }
+
+    uint32_t length = 0;
+    napi_get_array_length(env, args[0], &length);
+
+    std::vector<napi_value> js_configs(length);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_get_element(env, args[0], i, &js_configs[i]);
+    }
+
+    // onProgress (optional): function
+    napi_value js_progress = nullptr;
+    if (argc >= 2) {
+        napi_valuetype js_type = napi_undefined;
+        napi_typeof(env, args[1], &js_type);
+
+        if (js_type == napi_function) {
+            js_progress = args[1];
+        } else if (js_type != napi_undefined) {
+            napi::throw_with_message(env, "createContexts(configs, onProgress) onProgress must be a function");
+            return nullptr;
+        }
+    }
+
+    return start_load(env, std::move(js_configs), js_progress, false);
+}
+
 EXTERN_C_START
 static napi_value Init(napi_env env, napi_value exports) {
     napi_property_descriptor desc[] = {
-        {"createContext", nullptr, NAPI_Global_createContext, nullptr, nullptr, nullptr, napi_default, nullptr}};
+        {"createContext", nullptr, NAPI_Global_createContext, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"createContexts", nullptr, NAPI_Global_createContexts, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"createVectorIndex", nullptr, NAPI_Global_createVectorIndex, nullptr, nullptr, nullptr, napi_default,
+         nullptr},
+        {"createPipeline", nullptr, NAPI_Global_createPipeline, nullptr, nullptr, nullptr, napi_default, nullptr}};
     napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc);
     return exports;
 }
@@ -0,0 +1,270 @@
+#include "inference/core/detection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace inference::core {
+
+namespace {
+
+struct Candidate {
+  float score;
+  uint32_t row;
+  uint32_t label;
+};
+
+inline float sigmoid(float x) { return 1.0F / (1.0F + std::exp(-x)); }
+
+// Maps a row index to its grid cell (levels ordered by stride, cells row-major).
+class GridLookup {
+public:
+  GridLookup(const DetectionConfig &config, size_t num_rows) {
+    size_t first_row = 0;
+
+    for (uint32_t stride : config.strides) {
+      if (stride == 0) {
+        throw std::invalid_argument("Detection grid stride must be positive");
+      }
+
+      const uint32_t width = (config.input_width + stride - 1) / stride;
+      const uint32_t height = (config.input_height + stride - 1) / stride;
+      levels_.push_back({first_row, width, stride});
+      first_row += static_cast<size_t>(width) * height;
+    }
+
+    if (first_row != num_rows) {
+      throw std::invalid_argument("Detection grid size does not match the number of rows");
+    }
+  }
+
+  void cell(size_t row, float &gx, float &gy, float &stride) const {
+    auto level = levels_.rbegin();
+    while (level->first_row > row) {
+      ++level;
+    }
+
+    const size_t index = row - level->first_row;
+    gx = static_cast<float>(index % level->width);
+    gy = static_cast<float>(index / level->width);
+    stride = static_cast<float>(level->stride);
+  }
+
+private:
+  struct Level {
+    size_t first_row;
+    uint32_t width;
+    uint32_t stride;
+  };
+
+  std::vector<Level> levels_;
+};
+
+void validate(const DetectionConfig &config, size_t row_size, size_t num_rows) {
+  if (config.num_classes == 0) {
+    throw std::invalid_argument("Detection num_classes must be positive");
+  }
+
+  // sums in 64 bits: offsets come from user configs and may be close to UINT32_MAX
+  const bool fits = uint64_t{config.box_offset} + 4 <= row_size &&
+                    uint64_t{config.class_offset} + config.num_classes <= row_size &&
+                    config.objectness_offset < static_cast<int64_t>(row_size);
+  if (!fits) {
+    throw std::invalid_argument("Detection row layout does not fit the prediction row");
+  }
+
+  if (config.decoding == BoxDecoding::ANCHORS && config.anchors.size() != num_rows * 4) {
+    throw std::invalid_argument("Detection anchors do not match the number of rows");
+  }
+}
+
+std::vector<Candidate> select_candidates(std::span<const float> predictions, size_t row_size, size_t num_rows,
+                                         const DetectionConfig &config) {
+  const auto activate = [&config](float value) { return config.sigmoid ? sigmoid(value) : value; };
+  const float threshold = config.score_threshold;
+
+  std::vector<Candidate> candidates;
+
+  for (size_t row = 0; row < num_rows; ++row) {
+    const float *values = predictions.data() + row * row_size;
+
+    float objectness = 1.0F;
+    if (config.objectness_offset >= 0) {
+      objectness = activate(values[config.objectness_offset]);
+      if (config.sigmoid && objectness <= threshold) {
+        continue; // activated class scores are below 1, so the product cannot pass
+      }
+    }
+
+    const float *classes = values + config.class_offset;
+
+    if (config.multi_label) {
+      for (uint32_t c = 0; c < config.num_classes; ++c) {
+        const float score = objectness * activate(classes[c]);
+        if (score > threshold) {
+          candidates.push_back({score, static_cast<uint32_t>(row), c});
+        }
+      }
+      continue;
+    }
+
+    // the sigmoid is monotonic: pick the best class on raw values, activate once
+    const auto best = static_cast<uint32_t>(std::max_element(classes, classes + config.num_classes) - classes);
+    const float score = objectness * activate(classes[best]);
+    if (score > threshold) {
+      candidates.push_back({score, static_cast<uint32_t>(row), best});
+    }
+  }
+
+  const auto better = [](const Candidate &lhs, const Candidate &rhs) {
+    return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.row < rhs.row);
+  };
+
+  if (config.max_candidates != 0 && candidates.size() > config.max_candidates) {
+    const auto last = candidates.begin() + config.max_candidates;
+    std::nth_element(candidates.begin(), last, candidates.end(), better);
+    candidates.erase(last, candidates.end());
+  }
+
+  std::sort(candidates.begin(), candidates.end(), better);
+  return candidates;
+}
+
+// Structure-of-arrays boxes in candidate order, so the NMS inner loop streams memory.
+struct Boxes {
+  std::vector<float> x1, y1, x2, y2, area;
+
+  explicit Boxes(size_t count) : x1(count), y1(count), x2(count), y2(count), area(count) {}
+};
+
+Boxes decode_boxes(std::span<const float> predictions, size_t row_size, size_t num_rows,
+                   const std::vector<Candidate> &candidates, const DetectionConfig &config) {
+  Boxes boxes{candidates.size()};
+
+  std::unique_ptr<GridLookup> grid;
+  if (config.decoding == BoxDecoding::GRID) {
+    grid = std::make_unique<GridLookup>(config, num_rows);
+  }
+
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const size_t row = candidates[i].row;
+    const float *box = predictions.data() + row * row_size + config.box_offset;
+
+    float cx = box[0];
+    float cy = box[1];
+    float w = box[2];
+    float h = box[3];
+
+    switch (config.decoding) {
+    case BoxDecoding::ANCHORS: {
+      const float *anchor = config.anchors.data() + row * 4;
+      const auto &var = config.variances;
+      cx = anchor[0] + box[0] * var[0] * anchor[2];
+      cy = anchor[1] + box[1] * var[1] * anchor[3];
+      w = anchor[2] * std::exp(box[2] * var[2]);
+      h = anchor[3] * std::exp(box[3] * var[3]);
+      break;
+    }
+    case BoxDecoding::GRID: {
+      float gx = 0.0F, gy = 0.0F, stride = 0.0F;
+      grid->cell(row, gx, gy, stride);
+      cx = (gx + box[0]) * stride;
+      cy = (gy + box[1]) * stride;
+      w = std::exp(box[2]) * stride;
+      h = std::exp(box[3]) * stride;
+      break;
+    }
+    case BoxDecoding::NONE:
+    default:
+      if (config.box_format == BoxFormat::CORNERS) {
+        boxes.x1[i] = box[0];
+        boxes.y1[i] = box[1];
+        boxes.x2[i] = box[2];
+        boxes.y2[i] = box[3];
+        boxes.area[i] = std::max(0.0F, box[2] - box[0]) * std::max(0.0F, box[3] - box[1]);
+        continue;
+      }
+      break;
+    }
+
+    boxes.x1[i] = cx - 0.5F * w;
+    boxes.y1[i] = cy - 0.5F * h;
+    boxes.x2[i] = cx + 0.5F * w;
+    boxes.y2[i] = cy + 0.5F * h;
+    boxes.area[i] = std::max(0.0F, w) * std::max(0.0F, h);
+  }
+
+  return boxes;
+}
+
+std::vector<size_t> greedy_nms(const Boxes &boxes, const std::vector<Candidate> &candidates,
+                               const DetectionConfig &config) {
+  const size_t count = candidates.size();
+  const size_t limit = config.max_detections == 0 ? count : config.max_detections;
+
+  std::vector<uint8_t> suppressed(count, 0);
+  std::vector<size_t> kept;
+
+  for (size_t i = 0; i < count && kept.size() < limit; ++i) {
+    if (suppressed[i]) {
+      continue;
+    }
+    kept.push_back(i);
+
+    for (size_t j = i + 1; j < count; ++j) {
+      if (suppressed[j] || (!config.class_agnostic && candidates[j].label != candidates[i].label)) {
+        continue;
+      }
+
+      const float iw = std::min(boxes.x2[i], boxes.x2[j]) - std::max(boxes.x1[i], boxes.x1[j]);
+      const float ih = std::min(boxes.y2[i], boxes.y2[j]) - std::max(boxes.y1[i], boxes.y1[j]);
+      if (iw <= 0.0F || ih <= 0.0F) {
+        continue;
+      }
+
+      // iou > threshold, without the division
+      const float inter = iw * ih;
+      if (inter > config.iou_threshold * (boxes.area[i] + boxes.area[j] - inter)) {
+        suppressed[j] = 1;
+      }
+    }
+  }
+
+  return kept;
+}
+
+} // namespace
+
+Detections postprocess_detections(std::span<const float> predictions, size_t num_rows,
+                                  const DetectionConfig &config) {
+  if (num_rows == 0) {
+    return {};
+  }
+
+  if (predictions.size() % num_rows != 0) {
+    throw std::invalid_argument("Detection predictions size is not a multiple of the number of rows");
+  }
+
+  const size_t row_size = predictions.size() / num_rows;
+  validate(config, row_size, num_rows);
+
+  const auto candidates = select_candidates(predictions, row_size, num_rows, config);
+  const auto boxes = decode_boxes(predictions, row_size, num_rows, candidates, config);
+  const auto kept = greedy_nms(boxes, candidates, config);
+
+  Detections detections;
+  detections.boxes.reserve(kept.size() * 4);
+  detections.scores.reserve(kept.size());
+  detections.labels.reserve(kept.size());
+
+  for (size_t i : kept) {
+    detections.boxes.insert(detections.boxes.end(), {boxes.x1[i], boxes.y1[i], boxes.x2[i], boxes.y2[i]});
+    detections.scores.push_back(candidates[i].score);
+    detections.labels.push_back(candidates[i].label);
+  }
+
+  return detections;
+}
+
+} // namespace inference::core
@@ -0,0 +1,247 @@
+#include "inference/core/hash.hpp"
+
+#include <array>
+#include <cstring> // memcpy
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define INFERENCE_HASH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INFERENCE_HASH_SSE2 1
+#endif
+
+namespace inference::core {
+
+namespace {
+
+constexpr uint64_t kPrime32_1 = 0x9E3779B1ULL;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+
+constexpr size_t kLanes = 8;            // 64-bit accumulators
+constexpr size_t kStripeBytes = 64;     // bytes consumed per accumulate step
+constexpr size_t kStripesPerBlock = 16; // stripes between scrambles
+constexpr size_t kBlockBytes = kStripeBytes * kStripesPerBlock;
+
+// Secret layout (in 64-bit words):
+// [0, 23)  stripe keys; stripe s within a block uses words [s, s + 8)
+// [24, 32) scramble keys
+// [32, 40) merge keys
+constexpr size_t kScrambleOffset = 24;
+constexpr size_t kMergeOffset = 32;
+constexpr size_t kSecretWords = 40;
+
+constexpr std::array<uint64_t, kSecretWords> make_secret() {
+  std::array<uint64_t, kSecretWords> secret{};
+  uint64_t state = 0x243F6A8885A308D3ULL; // splitmix64 over the digits of pi
+
+  for (auto &word : secret) {
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    word = z ^ (z >> 31);
+  }
+
+  return secret;
+}
+
+alignas(16) constexpr std::array<uint64_t, kSecretWords> kSecret = make_secret();
+
+inline uint64_t read64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t read32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// 64x64 -> 128 multiply, folded to 64 bits
+inline uint64_t mul_fold64(uint64_t lhs, uint64_t rhs) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using uint128 = unsigned __int128; // compiler extension, silences -Wpedantic
+  const uint128 product = static_cast<uint128>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+  const uint64_t lo_lo = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+  const uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+  const uint64_t lo_hi = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+  const uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+  const uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFFULL);
+  return lower ^ upper;
+#endif
+}
+
+inline uint64_t avalanche(uint64_t h) {
+  h ^= h >> 37;
+  h *= 0x165667919E3779F9ULL;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t mix16(const uint8_t *p, const uint64_t *key, uint64_t seed) {
+  return mul_fold64(read64(p) ^ (key[0] + seed), read64(p + 8) ^ (key[1] - seed));
+}
+
+uint64_t hash_short(const uint8_t *p, size_t size, uint64_t seed) {
+  // size <= 16
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  if (size >= 8) {
+    lo = read64(p);
+    hi = read64(p + size - 8);
+  } else if (size >= 4) {
+    lo = read32(p);
+    hi = read32(p + size - 4);
+  } else if (size > 0) {
+    lo = static_cast<uint64_t>(p[0]) | (static_cast<uint64_t>(p[size / 2]) << 8) |
+         (static_cast<uint64_t>(p[size - 1]) << 16);
+  }
+
+  const uint64_t h = mul_fold64(lo ^ (kSecret[0] + seed), hi ^ (kSecret[1] - seed));
+  return avalanche(h ^ (size * kPrime64_1));
+}
+
+uint64_t hash_medium(const uint8_t *p, size_t size, uint64_t seed) {
+  // 16 < size < kStripeBytes: 16-byte chunks, the last one overlapping
+  uint64_t acc = size * kPrime64_1;
+  const size_t chunks = (size + 15) / 16;
+
+  for (size_t i = 0; i + 1 < chunks; ++i) {
+    acc += mix16(p + 16 * i, &kSecret[2 * i], seed);
+  }
+  acc += mix16(p + size - 16, &kSecret[2 * (chunks - 1)], seed);
+
+  return avalanche(acc);
+}
+
+#if defined(INFERENCE_HASH_NEON)
+
+inline void accumulate_stripe(uint64_t *acc, const uint8_t *p, const uint64_t *key) {
+  for (size_t i = 0; i < kLanes; i += 2) {
+    const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(p + 8 * i));
+    const uint64x2_t data_key = veorq_u64(data, vld1q_u64(key + i));
+    const uint64x2_t product = vmull_u32(vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+    const uint64x2_t swapped = vextq_u64(data, data, 1);
+    vst1q_u64(acc + i, vaddq_u64(vaddq_u64(vld1q_u64(acc + i), swapped), product));
+  }
+}
+
+inline void scramble(uint64_t *acc, const uint64_t *key) {
+  const uint32x2_t prime = vdup_n_u32(static_cast<uint32_t>(kPrime32_1));
+
+  for (size_t i = 0; i < kLanes; i += 2) {
+    uint64x2_t a = vld1q_u64(acc + i);
+    a = veorq_u64(a, vshrq_n_u64(a, 47));
+    a = veorq_u64(a, vld1q_u64(key + i));
+    const uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+    vst1q_u64(acc + i, vmlal_u32(hi, vmovn_u64(a), prime));
+  }
+}
+
+#elif defined(INFERENCE_HASH_SSE2)
+
+inline void accumulate_stripe(uint64_t *acc, const uint8_t *p, const uint64_t *key) {
+  for (size_t i = 0; i < kLanes; i += 2) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8 * i));
+    const __m128i data_key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + i)));
+    const __m128i product = _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i *dst = reinterpret_cast<__m128i *>(acc + i);
+    _mm_storeu_si128(dst, _mm_add_epi64(_mm_add_epi64(_mm_loadu_si128(dst), swapped), product));
+  }
+}
+
+inline void scramble(uint64_t *acc, const uint64_t *key) {
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+
+  for (size_t i = 0; i < kLanes; i += 2) {
+    __m128i *dst = reinterpret_cast<__m128i *>(acc + i);
+    __m128i a = _mm_loadu_si128(dst);
+    a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+    a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + i)));
+    const __m128i lo = _mm_mul_epu32(a, prime);
+    const __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    _mm_storeu_si128(dst, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  }
+}
+
+#else
+
+inline void accumulate_stripe(uint64_t *acc, const uint8_t *p, const uint64_t *key) {
+  for (size_t i = 0; i < kLanes; ++i) {
+    const uint64_t data = read64(p + 8 * i);
+    const uint64_t data_key = data ^ key[i];
+    acc[i ^ 1] += data;
+    acc[i] += (data_key & 0xFFFFFFFFULL) * (data_key >> 32);
+  }
+}
+
+inline void scramble(uint64_t *acc, const uint64_t *key) {
+  for (size_t i = 0; i < kLanes; ++i) {
+    uint64_t a = acc[i];
+    a ^= a >> 47;
+    a ^= key[i];
+    acc[i] = a * kPrime32_1;
+  }
+}
+
+#endif
+
+uint64_t hash_long(const uint8_t *p, size_t size, uint64_t seed) {
+  // size >= kStripeBytes
+  alignas(16) uint64_t acc[kLanes] = {
+      0xC2B2AE3DULL + seed,  kPrime64_1 - seed,    kPrime64_2,           0x9E3779B1ULL,
+      0x165667B19E3779F9ULL, 0x85EBCA77C2B2AE63ULL, 0x27D4EB2F165667C5ULL, 0x85EBCA77ULL,
+  };
+
+  const size_t blocks = (size - 1) / kBlockBytes;
+  for (size_t b = 0; b < blocks; ++b) {
+    const uint8_t *block = p + b * kBlockBytes;
+    for (size_t s = 0; s < kStripesPerBlock; ++s) {
+      accumulate_stripe(acc, block + s * kStripeBytes, &kSecret[s]);
+    }
+    scramble(acc, &kSecret[kScrambleOffset]);
+  }
+
+  // partial last block: full stripes, then one (possibly overlapping) final stripe
+  const uint8_t *tail = p + blocks * kBlockBytes;
+  const size_t stripes = (size - 1 - blocks * kBlockBytes) / kStripeBytes;
+  for (size_t s = 0; s < stripes; ++s) {
+    accumulate_stripe(acc, tail + s * kStripeBytes, &kSecret[s]);
+  }
+  accumulate_stripe(acc, p + size - kStripeBytes, &kSecret[kStripesPerBlock - 1]);
+
+  uint64_t result = size * kPrime64_1;
+  for (size_t i = 0; i < kLanes; i += 2) {
+    result += mul_fold64(acc[i] ^ kSecret[kMergeOffset + i], acc[i + 1] ^ kSecret[kMergeOffset + i + 1]);
+  }
+
+  return avalanche(result);
+}
+
+} // namespace
+
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed) {
+  const auto *p = static_cast<const uint8_t *>(data);
+
+  if (size <= 16) {
+    return hash_short(p, size, seed);
+  }
+
+  if (size < kStripeBytes) {
+    return hash_medium(p, size, seed);
+  }
+
+  return hash_long(p, size, seed);
+}
+
+} // namespace inference::core
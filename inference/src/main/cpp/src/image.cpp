@@ -0,0 +1,118 @@
+#include "inference/core/image.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace inference::core {
+
+namespace {
+
+// Source sample position along one axis: two neighbours and the weight of the second.
+struct Tap {
+  uint32_t i0;
+  uint32_t i1;
+  float w1;
+};
+
+std::vector<Tap> make_taps(float start, float extent, uint32_t src_size, uint32_t out_size) {
+  std::vector<Tap> taps(out_size);
+  const float scale = extent / static_cast<float>(out_size);
+  const auto last = static_cast<float>(src_size - 1);
+
+  for (uint32_t i = 0; i < out_size; ++i) {
+    const float pos = std::clamp(start + (static_cast<float>(i) + 0.5F) * scale - 0.5F, 0.0F, last);
+    const auto i0 = static_cast<uint32_t>(pos);
+    taps[i] = {i0, std::min(i0 + 1, src_size - 1), pos - static_cast<float>(i0)};
+  }
+
+  return taps;
+}
+
+bool is_image_layout(types::Layout layout) { return layout == types::Layout::NCHW || layout == types::Layout::NHWC; }
+
+} // namespace
+
+void crop_resize_normalize(const ImageView &src, const Roi &roi, uint32_t out_width, uint32_t out_height,
+                           types::Layout out_layout, const Normalization &norm, float *dst) {
+  const uint32_t channels = src.channels;
+
+  if (src.width == 0 || src.height == 0 || channels == 0 || out_width == 0 || out_height == 0) {
+    throw std::invalid_argument("Image sizes must be positive");
+  }
+
+  if (src.data.size() != static_cast<size_t>(src.width) * src.height * channels) {
+    throw std::invalid_argument("Image data size does not match its dimensions");
+  }
+
+  if (!is_image_layout(src.layout) || !is_image_layout(out_layout)) {
+    throw std::invalid_argument("Image layout must be NCHW or NHWC");
+  }
+
+  if ((!norm.mean.empty() && norm.mean.size() != channels) || (!norm.std.empty() && norm.std.size() != channels)) {
+    throw std::invalid_argument("Normalization must have one value per channel");
+  }
+
+  if (std::find(norm.std.begin(), norm.std.end(), 0.0F) != norm.std.end()) {
+    throw std::invalid_argument("Normalization std values must be non-zero");
+  }
+
+  // NaN passes std::clamp unchanged and would reach the float -> index conversion of the taps
+  if (!std::isfinite(roi.x1) || !std::isfinite(roi.y1) || !std::isfinite(roi.x2) || !std::isfinite(roi.y2)) {
+    throw std::invalid_argument("Image ROI coordinates must be finite");
+  }
+
+  const float roi_width = std::max(roi.x2 - roi.x1, 1.0F);
+  const float roi_height = std::max(roi.y2 - roi.y1, 1.0F);
+
+  const auto xs = make_taps(roi.x1, roi_width, src.width, out_width);
+  const auto ys = make_taps(roi.y1, roi_height, src.height, out_height);
+
+  // per-channel affine form: out = value * scale + bias
+  std::vector<float> scale(channels, 1.0F);
+  std::vector<float> bias(channels, 0.0F);
+  for (uint32_t c = 0; c < channels; ++c) {
+    const float s = norm.std.empty() ? 1.0F : norm.std[c];
+    const float m = norm.mean.empty() ? 0.0F : norm.mean[c];
+    scale[c] = 1.0F / s;
+    bias[c] = -m / s;
+  }
+
+  const float *pixels = src.data.data();
+  const size_t plane = static_cast<size_t>(src.width) * src.height;
+  const size_t out_plane = static_cast<size_t>(out_width) * out_height;
+
+  // element strides of the source: planar channels or interleaved pixels
+  const bool src_planar = src.layout == types::Layout::NCHW;
+  const size_t pixel_stride = src_planar ? 1 : channels;
+  const size_t channel_stride = src_planar ? plane : 1;
+
+  const bool out_planar = out_layout == types::Layout::NCHW;
+
+  for (uint32_t y = 0; y < out_height; ++y) {
+    const Tap ty = ys[y];
+    const size_t row0 = static_cast<size_t>(ty.i0) * src.width;
+    const size_t row1 = static_cast<size_t>(ty.i1) * src.width;
+
+    for (uint32_t c = 0; c < channels; ++c) {
+      const float *base = pixels + c * channel_stride;
+      const float *r0 = base + row0 * pixel_stride;
+      const float *r1 = base + row1 * pixel_stride;
+
+      float *out = out_planar ? dst + c * out_plane + static_cast<size_t>(y) * out_width
+                              : dst + static_cast<size_t>(y) * out_width * channels + c;
+      const size_t out_step = out_planar ? 1 : channels;
+
+      for (uint32_t x = 0; x < out_width; ++x) {
+        const Tap tx = xs[x];
+        const float top = r0[tx.i0 * pixel_stride] + (r0[tx.i1 * pixel_stride] - r0[tx.i0 * pixel_stride]) * tx.w1;
+        const float bottom = r1[tx.i0 * pixel_stride] + (r1[tx.i1 * pixel_stride] - r1[tx.i0 * pixel_stride]) * tx.w1;
+        const float value = top + (bottom - top) * ty.w1;
+
+        out[x * out_step] = value * scale[c] + bias[c];
+      }
+    }
+  }
+}
+
+} // namespace inference::core
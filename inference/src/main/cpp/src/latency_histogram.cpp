@@ -0,0 +1,136 @@
+#include "inference/core/latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace inference::core {
+
+namespace {
+
+constexpr uint64_t kSubBuckets = uint64_t{1} << LatencyHistogram::kSubBucketBits;
+
+void atomic_min(std::atomic<uint64_t> &target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+void atomic_max(std::atomic<uint64_t> &target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucket_index(uint64_t value) {
+  if (value < kSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+
+  // group g >= 1 covers [2^(g+4), 2^(g+5)) in 32 steps of 2^(g-1)
+  const auto msb = static_cast<uint32_t>(63 - std::countl_zero(value));
+  if (msb >= kMaxBits) {
+    return kBucketCount - 1;
+  }
+
+  const uint32_t shift = msb - kSubBucketBits;
+  const uint64_t top = value >> shift; // [32, 64)
+  return static_cast<size_t>((shift + 1) * kSubBuckets + (top - kSubBuckets));
+}
+
+uint64_t LatencyHistogram::bucket_upper(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  const uint64_t shift = index / kSubBuckets - 1;
+  const uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+  counts_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  atomic_min(min_, value);
+  atomic_max(max_, value);
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+  LatencySnapshot snapshot;
+  snapshot.counts.resize(kBucketCount);
+
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    snapshot.counts[i] = counts_[i].load(std::memory_order_relaxed);
+  }
+
+  snapshot.count = count_.load(std::memory_order_relaxed);
+  snapshot.sum = sum_.load(std::memory_order_relaxed);
+  snapshot.max = max_.load(std::memory_order_relaxed);
+  snapshot.min = snapshot.count > 0 ? min_.load(std::memory_order_relaxed) : 0;
+  return snapshot;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencySnapshot::quantile(double quantile) const {
+  // bucket counts are summed rather than trusting `count`, which may be
+  // slightly ahead of them in a concurrent snapshot
+  uint64_t total = 0;
+  for (uint64_t c : counts) {
+    total += c;
+  }
+
+  if (total == 0) {
+    return 0;
+  }
+
+  if (quantile <= 0.0) {
+    return min;
+  }
+
+  const double clamped = std::min(quantile, 1.0);
+  const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(total))));
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return std::min(std::max(LatencyHistogram::bucket_upper(i), min), max);
+    }
+  }
+
+  return max;
+}
+
+void LatencySnapshot::merge(const LatencySnapshot &other) {
+  if (other.count == 0) {
+    return;
+  }
+
+  if (counts.size() < other.counts.size()) {
+    counts.resize(other.counts.size());
+  }
+
+  for (size_t i = 0; i < other.counts.size(); ++i) {
+    counts[i] += other.counts[i];
+  }
+
+  min = count > 0 ? std::min(min, other.min) : other.min;
+  max = std::max(max, other.max);
+  count += other.count;
+  sum += other.sum;
+}
+
+} // namespace inference::core
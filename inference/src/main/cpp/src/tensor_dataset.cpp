@@ -0,0 +1,245 @@
+#include "inference/core/tensor_dataset.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace inference::core {
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'I', 'N', 'F', 'T', 'D', 'S', '0', '1'};
+
+struct FileHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t count;
+  uint64_t index_offset;
+  std::array<uint8_t, 32> padding;
+};
+
+struct RecordHeader {
+  uint32_t dtype;
+  uint32_t layout;
+  uint32_t rank;
+  uint32_t reserved;
+  uint64_t payload_bytes;
+  std::array<uint32_t, dataset::kMaxRank> dims;
+  std::array<uint8_t, 8> padding;
+};
+
+static_assert(sizeof(FileHeader) == dataset::kAlignment);
+static_assert(sizeof(RecordHeader) == dataset::kAlignment);
+
+uint64_t align_up(uint64_t value) { return (value + dataset::kAlignment - 1) & ~uint64_t{dataset::kAlignment - 1}; }
+
+bool valid_dtype(uint32_t dtype) {
+  return dtype != 0 && types::element_size(static_cast<types::DataType>(dtype)) != 0;
+}
+
+bool valid_layout(uint32_t layout) { return layout <= static_cast<uint32_t>(types::Layout::NHWC); }
+
+} // namespace
+
+std::span<const float> TensorRecordView::floats() const {
+  if (dtype != types::DataType::FLOAT32) {
+    throw std::runtime_error("Dataset record is not FLOAT32");
+  }
+  return {reinterpret_cast<const float *>(bytes.data()), bytes.size() / sizeof(float)};
+}
+
+// --- writer ---
+
+TensorDatasetWriter::TensorDatasetWriter(const std::string &path)
+    : out_{path, std::ios::binary | std::ios::trunc} {
+  if (!out_) {
+    throw std::runtime_error("Failed to create dataset: " + path);
+  }
+
+  // placeholder, rewritten by finish()
+  const FileHeader header{};
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  position_ = sizeof(header);
+}
+
+// an unfinished file keeps the zeroed placeholder header, so readers reject it
+TensorDatasetWriter::~TensorDatasetWriter() = default;
+
+void TensorDatasetWriter::append(std::span<const uint8_t> bytes, const types::Shape &shape, types::Layout layout,
+                                 types::DataType dtype) {
+  if (finished_) {
+    throw std::logic_error("Dataset is already finished");
+  }
+
+  if (shape.size() > dataset::kMaxRank) {
+    throw std::invalid_argument("Dataset record rank exceeds " + std::to_string(dataset::kMaxRank));
+  }
+
+  if (types::element_size(dtype) == 0 || bytes.size() != types::numel(shape) * types::element_size(dtype)) {
+    throw std::invalid_argument("Dataset record size does not match its shape and dtype");
+  }
+
+  RecordHeader header{};
+  header.dtype = static_cast<uint32_t>(dtype);
+  header.layout = static_cast<uint32_t>(layout);
+  header.rank = static_cast<uint32_t>(shape.size());
+  header.payload_bytes = bytes.size();
+  std::copy(shape.begin(), shape.end(), header.dims.begin());
+
+  offsets_.push_back(position_);
+
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  position_ += sizeof(header) + bytes.size();
+  pad();
+
+  if (!out_) {
+    throw std::runtime_error("Failed to write dataset record");
+  }
+}
+
+void TensorDatasetWriter::pad() {
+  static constexpr std::array<char, dataset::kAlignment> zeros{};
+
+  const uint64_t aligned = align_up(position_);
+  out_.write(zeros.data(), static_cast<std::streamsize>(aligned - position_));
+  position_ = aligned;
+}
+
+void TensorDatasetWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+
+  FileHeader header{};
+  header.magic = kMagic;
+  header.version = dataset::kVersion;
+  header.count = offsets_.size();
+  header.index_offset = position_;
+
+  out_.write(reinterpret_cast<const char *>(offsets_.data()),
+             static_cast<std::streamsize>(offsets_.size() * sizeof(uint64_t)));
+  position_ += offsets_.size() * sizeof(uint64_t);
+  pad();
+
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.close();
+
+  if (!out_) {
+    throw std::runtime_error("Failed to finish dataset");
+  }
+}
+
+// --- reader ---
+
+TensorDataset::TensorDataset(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open dataset: " + path);
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+    ::close(fd);
+    throw std::runtime_error("Dataset is truncated: " + path);
+  }
+
+  bytes_ = static_cast<size_t>(st.st_size);
+  void *mapping = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping keeps the file referenced
+
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Failed to map dataset: " + path);
+  }
+  data_ = static_cast<const uint8_t *>(mapping);
+
+  try {
+    FileHeader header{};
+    std::memcpy(&header, data_, sizeof(header));
+
+    if (header.magic != kMagic || header.version != dataset::kVersion) {
+      throw std::runtime_error("Not a tensor dataset (or unsupported version): " + path);
+    }
+
+    if (header.index_offset % dataset::kAlignment != 0 || header.index_offset < sizeof(FileHeader) ||
+        header.index_offset > bytes_ ||
+        header.count > (bytes_ - header.index_offset) / sizeof(uint64_t)) {
+      throw std::runtime_error("Dataset index is truncated: " + path);
+    }
+
+    count_ = static_cast<size_t>(header.count);
+    index_ = reinterpret_cast<const uint64_t *>(data_ + header.index_offset);
+
+    // records are stored in index order without overlap, which prefetch() relies on
+    uint64_t previous_end = sizeof(FileHeader);
+    for (size_t i = 0; i < count_; ++i) {
+      const uint64_t offset = index_[i];
+      if (offset % dataset::kAlignment != 0 || offset < sizeof(FileHeader) ||
+          offset > header.index_offset - sizeof(RecordHeader)) {
+        throw std::runtime_error("Dataset record " + std::to_string(i) + " is out of bounds: " + path);
+      }
+
+      if (offset < previous_end) {
+        throw std::runtime_error("Dataset record " + std::to_string(i) + " is out of order: " + path);
+      }
+
+      const auto *record = reinterpret_cast<const RecordHeader *>(data_ + offset);
+      const types::Shape shape(record->dims.begin(), record->dims.begin() + std::min(record->rank, dataset::kMaxRank));
+
+      if (record->rank > dataset::kMaxRank || !valid_dtype(record->dtype) || !valid_layout(record->layout) ||
+          record->payload_bytes !=
+              types::numel(shape) * types::element_size(static_cast<types::DataType>(record->dtype)) ||
+          record->payload_bytes > header.index_offset - offset - sizeof(RecordHeader)) {
+        throw std::runtime_error("Dataset record " + std::to_string(i) + " is malformed: " + path);
+      }
+
+      previous_end = offset + sizeof(RecordHeader) + record->payload_bytes;
+    }
+  } catch (...) {
+    ::munmap(const_cast<uint8_t *>(data_), bytes_);
+    throw;
+  }
+}
+
+TensorDataset::~TensorDataset() { ::munmap(const_cast<uint8_t *>(data_), bytes_); }
+
+TensorRecordView TensorDataset::record(size_t index) const {
+  if (index >= count_) {
+    throw std::out_of_range("Dataset record index out of range");
+  }
+
+  const auto *header = reinterpret_cast<const RecordHeader *>(data_ + index_[index]);
+
+  TensorRecordView view;
+  view.bytes = {data_ + index_[index] + sizeof(RecordHeader), static_cast<size_t>(header->payload_bytes)};
+  view.shape.assign(header->dims.begin(), header->dims.begin() + header->rank);
+  view.layout = static_cast<types::Layout>(header->layout);
+  view.dtype = static_cast<types::DataType>(header->dtype);
+  return view;
+}
+
+void TensorDataset::prefetch(size_t first, size_t count) const {
+  if (first >= count_ || count == 0) {
+    return;
+  }
+
+  const size_t last = std::min(count_, first + count) - 1;
+  const auto *last_header = reinterpret_cast<const RecordHeader *>(data_ + index_[last]);
+
+  const auto page = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+  const uint64_t begin = index_[first] / page * page;
+  const uint64_t end = index_[last] + sizeof(RecordHeader) + last_header->payload_bytes;
+
+  ::madvise(const_cast<uint8_t *>(data_) + begin, end - begin, MADV_WILLNEED);
+}
+
+} // namespace inference::core
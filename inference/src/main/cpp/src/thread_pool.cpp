@@ -0,0 +1,99 @@
+#include "inference/core/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace inference::core {
+
+ThreadPool::ThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this] { worker_loop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+  {
+    std::scoped_lock lock{mutex_};
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void ThreadPool::worker_loop() {
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock lock{mutex_};
+      cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+      if (tasks_.empty()) {
+        return; // stopping and drained
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+void ThreadPool::parallel_for(size_t count, size_t min_chunk, const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+
+  // the calling thread takes one chunk itself
+  const size_t max_chunks = std::max<size_t>(1, count / std::max<size_t>(1, min_chunk));
+  const size_t chunks = std::min(size() + 1, max_chunks);
+  const size_t chunk_size = (count + chunks - 1) / chunks;
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(chunks - 1);
+
+  for (size_t begin = chunk_size; begin < count; begin += chunk_size) {
+    const size_t end = std::min(count, begin + chunk_size);
+    pending.push_back(submit([&fn, begin, end] { fn(begin, end); }));
+  }
+
+  std::exception_ptr error;
+  try {
+    fn(0, std::min(count, chunk_size));
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // wait for every chunk before returning: they reference `fn`
+  for (auto &future : pending) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace inference::core
@@ -0,0 +1,121 @@
+#include "inference/core/tuning_store.hpp"
+
+#include <algorithm>
+#include <cstdint> // int64_t, UINT32_MAX
+#include <cstdio> // std::rename
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace inference::core {
+
+namespace {
+
+std::mutex &store_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// parses one entry; values are read signed so that negative numbers are rejected instead of wrapping
+std::optional<std::pair<std::string, TunedConfig>> parse_entry(const std::string &line) {
+  std::istringstream fields{line};
+  std::string key;
+  int64_t threads = 0;
+  int64_t instances = 0;
+  int64_t max_batch_size = 0;
+  int64_t max_delay_us = 0;
+
+  if (!(fields >> key >> threads >> instances >> max_batch_size >> max_delay_us)) {
+    return std::nullopt;
+  }
+
+  // a zero count would make every later load fail, so such lines are skipped like unparseable ones
+  const auto positive = [](int64_t value) { return value > 0 && value <= UINT32_MAX; };
+  if (!positive(threads) || !positive(instances) || !positive(max_batch_size) || max_delay_us < 0) {
+    return std::nullopt;
+  }
+
+  return std::pair{key, TunedConfig{.threads = static_cast<uint32_t>(threads),
+                                    .instances = static_cast<uint32_t>(instances),
+                                    .max_batch_size = static_cast<uint32_t>(max_batch_size),
+                                    .max_delay_us = static_cast<uint64_t>(max_delay_us)}};
+}
+
+std::map<std::string, TunedConfig> read_entries(const std::string &path) {
+  std::map<std::string, TunedConfig> entries;
+
+  std::ifstream in{path};
+  std::string line;
+  while (std::getline(in, line)) {
+    if (auto entry = parse_entry(line)) {
+      entries[entry->first] = entry->second;
+    }
+  }
+
+  return entries;
+}
+
+} // namespace
+
+std::string cpu_topology() {
+  const unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+
+  std::string topology = std::to_string(cores) + ":";
+  for (unsigned cpu = 0; cpu < cores; ++cpu) {
+    std::ifstream in{"/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/cpuinfo_max_freq"};
+    uint64_t khz = 0;
+    in >> khz;
+
+    topology += (cpu > 0 ? "," : "") + std::to_string(khz);
+  }
+
+  return topology;
+}
+
+std::string tuning_key(uint64_t model_hash, const std::string &topology) {
+  std::ostringstream key;
+  key << std::hex << model_hash << '@' << topology;
+  return key.str();
+}
+
+std::optional<TunedConfig> TuningStore::load(const std::string &key) const {
+  std::scoped_lock lock{store_mutex()};
+
+  const auto entries = read_entries(path_);
+  const auto it = entries.find(key);
+  if (it == entries.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void TuningStore::save(const std::string &key, const TunedConfig &config) const {
+  std::scoped_lock lock{store_mutex()};
+
+  auto entries = read_entries(path_);
+  entries[key] = config;
+
+  const std::string tmp = path_ + ".tmp";
+  {
+    std::ofstream out{tmp, std::ios::trunc};
+    for (const auto &[entry_key, entry] : entries) {
+      out << entry_key << ' ' << entry.threads << ' ' << entry.instances << ' ' << entry.max_batch_size << ' '
+          << entry.max_delay_us << '\n';
+    }
+
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Failed to write tuning store: " + tmp);
+    }
+  }
+
+  if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+    throw std::runtime_error("Failed to replace tuning store: " + path_);
+  }
+}
+
+} // namespace inference::core
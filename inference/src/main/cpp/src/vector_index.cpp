@@ -0,0 +1,333 @@
+#include "inference/core/vector_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define INFERENCE_DOT_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INFERENCE_DOT_SSE2 1
+#endif
+
+namespace inference::core {
+
+namespace {
+
+// Below this many multiply-adds per query, threading costs more than it saves.
+constexpr size_t kParallelMinWork = size_t{1} << 16;
+
+float dot_f32(const float *a, const float *b, size_t n) {
+  size_t i = 0;
+  float sum = 0.0F;
+
+#if defined(INFERENCE_DOT_NEON)
+  float32x4_t acc0 = vdupq_n_f32(0.0F);
+  float32x4_t acc1 = vdupq_n_f32(0.0F);
+  float32x4_t acc2 = vdupq_n_f32(0.0F);
+  float32x4_t acc3 = vdupq_n_f32(0.0F);
+
+  for (; i + 16 <= n; i += 16) {
+    acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    acc2 = vfmaq_f32(acc2, vld1q_f32(a + i + 8), vld1q_f32(b + i + 8));
+    acc3 = vfmaq_f32(acc3, vld1q_f32(a + i + 12), vld1q_f32(b + i + 12));
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+  }
+
+  sum = vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+#elif defined(INFERENCE_DOT_SSE2)
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  __m128 acc2 = _mm_setzero_ps();
+  __m128 acc3 = _mm_setzero_ps();
+
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+    acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+  sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+
+  return sum;
+}
+
+// Inputs are symmetric-quantized to [-127, 127], so 16-bit pair sums cannot overflow.
+int32_t dot_i8(const int8_t *a, const int8_t *b, size_t n) {
+  size_t i = 0;
+  int32_t sum = 0;
+
+#if defined(INFERENCE_DOT_NEON)
+  int32x4_t acc = vdupq_n_s32(0);
+
+  for (; i + 16 <= n; i += 16) {
+    const int8x16_t va = vld1q_s8(a + i);
+    const int8x16_t vb = vld1q_s8(b + i);
+    int16x8_t products = vmull_s8(vget_low_s8(va), vget_low_s8(vb));
+    products = vmlal_high_s8(products, va, vb);
+    acc = vpadalq_s16(acc, products);
+  }
+
+  sum = vaddvq_s32(acc);
+#elif defined(INFERENCE_DOT_SSE2)
+  __m128i acc = _mm_setzero_si128();
+
+  for (; i + 16 <= n; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    // sign-extend to 16 bits: duplicate each byte, then arithmetic shift
+    const __m128i a_lo = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+    const __m128i a_hi = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+    const __m128i b_lo = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+    const __m128i b_hi = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(a_lo, b_lo));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(a_hi, b_hi));
+  }
+
+  alignas(16) int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; i < n; ++i) {
+    sum += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+  }
+
+  return sum;
+}
+
+// symmetric per-vector quantization; returns the dequantization scale
+float quantize(std::span<const float> src, int8_t *dst) {
+  float max_abs = 0.0F;
+  for (float value : src) {
+    max_abs = std::max(max_abs, std::fabs(value));
+  }
+
+  const float scale = max_abs > 0.0F ? max_abs / 127.0F : 1.0F;
+  const float inv_scale = 1.0F / scale;
+
+  for (size_t i = 0; i < src.size(); ++i) {
+    const float q = std::nearbyint(src[i] * inv_scale);
+    dst[i] = static_cast<int8_t>(std::clamp(q, -127.0F, 127.0F));
+  }
+
+  return scale;
+}
+
+void normalize(std::vector<float> &vector) {
+  const float norm = std::sqrt(dot_f32(vector.data(), vector.data(), vector.size()));
+  if (norm > 0.0F) {
+    for (float &value : vector) {
+      value /= norm;
+    }
+  }
+}
+
+} // namespace
+
+struct VectorIndex::Prepared {
+  std::vector<float> f32;
+  std::vector<int8_t> i8;
+  float scale = 1.0F;
+  float norm = 0.0F; // squared L2 norm
+};
+
+VectorIndex::VectorIndex(VectorIndexConfig config) : config_{config} {
+  if (config_.dim == 0) {
+    throw std::invalid_argument("VectorIndex dim must be positive");
+  }
+
+  if (config_.storage != types::DataType::FLOAT32 && config_.storage != types::DataType::INT8) {
+    throw std::invalid_argument("VectorIndex storage must be FLOAT32 or INT8");
+  }
+
+  const size_t threads = config_.threads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : config_.threads;
+  if (threads > 1) {
+    pool_ = std::make_unique<ThreadPool>(threads - 1); // the querying thread takes a share too
+  }
+}
+
+VectorIndex::~VectorIndex() = default;
+
+VectorIndex::Prepared VectorIndex::prepare(std::span<const float> vector) const {
+  if (vector.size() != config_.dim) {
+    throw std::invalid_argument("Vector dimension mismatch (expected " + std::to_string(config_.dim) + ")");
+  }
+
+  Prepared prepared;
+  prepared.f32.assign(vector.begin(), vector.end());
+
+  if (config_.metric == Metric::COSINE) {
+    normalize(prepared.f32);
+  }
+
+  if (config_.storage == types::DataType::INT8) {
+    prepared.i8.resize(config_.dim);
+    prepared.scale = quantize(prepared.f32, prepared.i8.data());
+
+    // norm of the dequantized vector keeps L2 distances consistent with the approximate dot
+    const auto dot = static_cast<float>(dot_i8(prepared.i8.data(), prepared.i8.data(), config_.dim));
+    prepared.norm = dot * prepared.scale * prepared.scale;
+  } else {
+    prepared.norm = dot_f32(prepared.f32.data(), prepared.f32.data(), config_.dim);
+  }
+
+  return prepared;
+}
+
+void VectorIndex::add(uint32_t id, std::span<const float> vector) {
+  Prepared prepared = prepare(vector);
+  const size_t dim = config_.dim;
+
+  std::unique_lock lock{mutex_};
+
+  size_t row = ids_.size();
+  if (auto it = rows_by_id_.find(id); it != rows_by_id_.end()) {
+    row = it->second;
+  } else {
+    ids_.push_back(id);
+    norms_.push_back(0.0F);
+    if (config_.storage == types::DataType::INT8) {
+      rows_i8_.resize(rows_i8_.size() + dim);
+      scales_.push_back(1.0F);
+    } else {
+      rows_f32_.resize(rows_f32_.size() + dim);
+    }
+    rows_by_id_.emplace(id, row);
+  }
+
+  norms_[row] = prepared.norm;
+  if (config_.storage == types::DataType::INT8) {
+    std::copy(prepared.i8.begin(), prepared.i8.end(), rows_i8_.begin() + static_cast<std::ptrdiff_t>(row * dim));
+    scales_[row] = prepared.scale;
+  } else {
+    std::copy(prepared.f32.begin(), prepared.f32.end(), rows_f32_.begin() + static_cast<std::ptrdiff_t>(row * dim));
+  }
+}
+
+bool VectorIndex::remove(uint32_t id) {
+  std::unique_lock lock{mutex_};
+
+  auto it = rows_by_id_.find(id);
+  if (it == rows_by_id_.end()) {
+    return false;
+  }
+
+  const size_t row = it->second;
+  const size_t last = ids_.size() - 1;
+  const size_t dim = config_.dim;
+  rows_by_id_.erase(it);
+
+  if (row != last) {
+    ids_[row] = ids_[last];
+    norms_[row] = norms_[last];
+    rows_by_id_[ids_[row]] = row;
+
+    if (config_.storage == types::DataType::INT8) {
+      std::copy_n(rows_i8_.begin() + static_cast<std::ptrdiff_t>(last * dim), dim,
+                  rows_i8_.begin() + static_cast<std::ptrdiff_t>(row * dim));
+      scales_[row] = scales_[last];
+    } else {
+      std::copy_n(rows_f32_.begin() + static_cast<std::ptrdiff_t>(last * dim), dim,
+                  rows_f32_.begin() + static_cast<std::ptrdiff_t>(row * dim));
+    }
+  }
+
+  ids_.pop_back();
+  norms_.pop_back();
+  if (config_.storage == types::DataType::INT8) {
+    rows_i8_.resize(last * dim);
+    scales_.pop_back();
+  } else {
+    rows_f32_.resize(last * dim);
+  }
+
+  return true;
+}
+
+size_t VectorIndex::size() const {
+  std::shared_lock lock{mutex_};
+  return ids_.size();
+}
+
+void VectorIndex::score_rows(const Prepared &query, size_t begin, size_t end, float *scores) const {
+  const size_t dim = config_.dim;
+
+  for (size_t row = begin; row < end; ++row) {
+    float dot = 0.0F;
+    if (config_.storage == types::DataType::INT8) {
+      const auto raw = static_cast<float>(dot_i8(query.i8.data(), rows_i8_.data() + row * dim, dim));
+      dot = raw * query.scale * scales_[row];
+    } else {
+      dot = dot_f32(query.f32.data(), rows_f32_.data() + row * dim, dim);
+    }
+
+    // higher is better for ranking; L2 ranks by negative squared distance
+    scores[row] = config_.metric == Metric::COSINE ? dot : -(query.norm + norms_[row] - 2.0F * dot);
+  }
+}
+
+std::vector<SearchResult> VectorIndex::query(std::span<const float> vector, size_t k) const {
+  const Prepared prepared = prepare(vector);
+
+  std::shared_lock lock{mutex_};
+
+  const size_t rows = ids_.size();
+  k = std::min(k, rows);
+  if (k == 0) {
+    return {};
+  }
+
+  std::vector<float> scores(rows);
+  const size_t dim = config_.dim;
+
+  if (pool_ && rows * dim >= kParallelMinWork) {
+    const size_t min_chunk = std::max<size_t>(1, kParallelMinWork / dim);
+    pool_->parallel_for(rows, min_chunk,
+                        [&](size_t begin, size_t end) { score_rows(prepared, begin, end, scores.data()); });
+  } else {
+    score_rows(prepared, 0, rows, scores.data());
+  }
+
+  std::vector<uint32_t> order(rows);
+  std::iota(order.begin(), order.end(), 0U);
+
+  const auto better = [&scores](uint32_t lhs, uint32_t rhs) {
+    return scores[lhs] > scores[rhs] || (scores[lhs] == scores[rhs] && lhs < rhs);
+  };
+
+  const auto kth = order.begin() + static_cast<std::ptrdiff_t>(k);
+  std::nth_element(order.begin(), kth - 1, order.end(), better);
+  std::sort(order.begin(), kth, better);
+
+  std::vector<SearchResult> results(k);
+  for (size_t i = 0; i < k; ++i) {
+    const float score = scores[order[i]];
+    results[i].id = ids_[order[i]];
+    results[i].score = config_.metric == Metric::COSINE ? score : std::sqrt(std::max(0.0F, -score));
+  }
+
+  return results;
+}
+
+} // namespace inference::core
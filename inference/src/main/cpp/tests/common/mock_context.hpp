@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "inference/context.hpp"
+#include "inference/mock_backend.hpp"
+#include "inference/types.hpp"
+
+// Shared fixtures of the host tests: Contexts over MockBackends.
+namespace inference::test {
+
+struct MockContext {
+  MockBackend *backend; // owned by `context`
+  std::unique_ptr<Context> context;
+};
+
+// Context with a single, fixed MockBackend
+inline MockContext make_mock_context(ModelConfig config = {}, MockConfig mock = {.output_size = 4}) {
+  auto backend = std::make_unique<MockBackend>(mock);
+  auto *raw = backend.get();
+  return {raw, std::make_unique<Context>(std::move(config), std::move(backend))};
+}
+
+// Reconfigurable Context: every instance is a MockBackend simulating the configured thread count
+// and returning the configured output, as the MOCK device does
+inline std::unique_ptr<Context> make_mock_pool(ModelConfig config, MockConfig mock) {
+  return std::make_unique<Context>(std::move(config), [mock](const ModelConfig &model) {
+    MockConfig instance = mock;
+    instance.threads = model.execution.threads;
+    instance.output_name = model.output_name;
+    return std::make_unique<MockBackend>(instance);
+  });
+}
+
+} // namespace inference::test
@@ -0,0 +1,415 @@
+// Load generator for inference::Context on the host.
+//
+// Drives a Context backed by MockBackend instances (with an optional synthetic
+// predict cost) from a fixed number of client threads and prints throughput,
+// latency percentiles and a queue-wait breakdown as JSON on stdout. The Context
+// is built from a backend factory, so --instances and --threads exercise the
+// instance pool the way the MOCK device does.
+//
+// Closed loop (--rate=0): every client issues its next request as soon as the
+// previous one returns. Open loop (--rate=R): requests are scheduled at R per
+// second (evenly spaced or --poisson) independently of completions; latency is
+// measured from the scheduled time, so a saturated system shows up as client
+// queueing instead of being hidden (no coordinated omission). --concurrency
+// bounds the number of requests in flight in both modes.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "inference/context.hpp"
+#include "inference/mock_backend.hpp"
+#include "inference/core/latency_histogram.hpp"
+
+using namespace inference;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::uint32_t concurrency = 4;
+  double rate = 0.0; // requests per second, 0 = closed loop
+  bool poisson = false;
+  std::uint64_t requests = 2000;
+  std::uint64_t warmup = 100;
+  std::uint32_t distinct_inputs = 16;
+  std::uint64_t seed = 1;
+
+  Shape shape{1, 3, 224, 224};
+
+  MockConfig mock{.output_size = 1000};
+  std::uint32_t instances = 1;
+  std::uint32_t threads = 1;
+  std::uint32_t max_batch_size = 1;
+  std::uint32_t max_delay_us = 2000;
+  std::uint32_t cache_entries = 0;
+};
+
+void print_usage() {
+  std::cerr << "usage: load_generator [options]\n"
+               "  --concurrency=N        client threads / max requests in flight (default: 4)\n"
+               "  --rate=R               open-loop arrival rate in requests/s, 0 = closed loop (default: 0)\n"
+               "  --poisson              exponential inter-arrival times in open loop\n"
+               "  --requests=N           measured requests (default: 2000)\n"
+               "  --warmup=N             unmeasured requests before the run (default: 100)\n"
+               "  --shape=D0,D1,...      input shape (default: 1,3,224,224)\n"
+               "  --batch-size=N         input batch dimension (overrides the first dim of --shape)\n"
+               "  --distinct-inputs=N    number of different input tensors cycled through (default: 16)\n"
+               "  --output-size=N        mock output values per sample (default: 1000)\n"
+               "  --predict-cost-us=N    synthetic cost of every predict call (default: 0)\n"
+               "  --sample-cost-us=N     additional synthetic cost per sample (default: 0)\n"
+               "  --instances=N          backend instances predicting concurrently (default: 1)\n"
+               "  --threads=N            simulated threads per instance (default: 1)\n"
+               "  --parallel-fraction=P  share of the cost that scales with --threads, 0..1 (default: 0)\n"
+               "  --max-batch-size=N     micro-batching, > 1 enables it (default: 1)\n"
+               "  --max-delay-us=N       micro-batching max delay (default: 2000)\n"
+               "  --cache-entries=N      result cache entries, 0 = disabled (default: 0)\n"
+               "  --seed=N               seed of the Poisson schedule (default: 1)\n";
+}
+
+std::uint64_t parse_uint(const std::string &name, const std::string &value) {
+  size_t pos = 0;
+  const bool valid = !value.empty() && value.front() >= '0' && value.front() <= '9';
+  const auto result = valid ? std::stoull(value, &pos) : 0;
+
+  if (!valid || pos != value.size()) {
+    throw std::invalid_argument(name + " expects a non-negative integer");
+  }
+  return result;
+}
+
+std::uint32_t parse_uint32(const std::string &name, const std::string &value) {
+  const auto result = parse_uint(name, value);
+  if (result > UINT32_MAX) {
+    throw std::invalid_argument(name + " is out of range");
+  }
+  return static_cast<std::uint32_t>(result);
+}
+
+Shape parse_shape(const std::string &value) {
+  Shape shape;
+  std::stringstream stream{value};
+  std::string dim;
+
+  while (std::getline(stream, dim, ',')) {
+    shape.push_back(parse_uint32("--shape", dim));
+    if (shape.back() == 0) {
+      throw std::invalid_argument("--shape dimensions must be positive");
+    }
+  }
+
+  if (shape.empty()) {
+    throw std::invalid_argument("--shape must not be empty");
+  }
+  return shape;
+}
+
+Options parse_options(int argc, char **argv) {
+  Options options;
+  std::uint32_t batch_size = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto eq = arg.find('=');
+    const std::string name = arg.substr(0, eq);
+    const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+
+    if (name == "--poisson") {
+      options.poisson = true;
+    } else if (value.empty()) {
+      throw std::invalid_argument("unknown option or missing value: " + arg);
+    } else if (name == "--concurrency") {
+      options.concurrency = parse_uint32(name, value);
+    } else if (name == "--rate") {
+      size_t pos = 0;
+      options.rate = std::stod(value, &pos);
+      if (pos != value.size()) {
+        throw std::invalid_argument("--rate expects a number");
+      }
+    } else if (name == "--requests") {
+      options.requests = parse_uint(name, value);
+    } else if (name == "--warmup") {
+      options.warmup = parse_uint(name, value);
+    } else if (name == "--shape") {
+      options.shape = parse_shape(value);
+    } else if (name == "--batch-size") {
+      batch_size = parse_uint32(name, value);
+    } else if (name == "--distinct-inputs") {
+      options.distinct_inputs = parse_uint32(name, value);
+    } else if (name == "--output-size") {
+      options.mock.output_size = parse_uint32(name, value);
+    } else if (name == "--predict-cost-us") {
+      options.mock.predict_cost = std::chrono::microseconds{parse_uint32(name, value)};
+    } else if (name == "--sample-cost-us") {
+      options.mock.sample_cost = std::chrono::microseconds{parse_uint32(name, value)};
+    } else if (name == "--instances") {
+      options.instances = parse_uint32(name, value);
+    } else if (name == "--threads") {
+      options.threads = parse_uint32(name, value);
+    } else if (name == "--parallel-fraction") {
+      size_t pos = 0;
+      options.mock.parallel_fraction = std::stod(value, &pos);
+      if (pos != value.size() || options.mock.parallel_fraction < 0.0 || options.mock.parallel_fraction > 1.0) {
+        throw std::invalid_argument("--parallel-fraction expects a number in [0, 1]");
+      }
+    } else if (name == "--max-batch-size") {
+      options.max_batch_size = parse_uint32(name, value);
+    } else if (name == "--max-delay-us") {
+      options.max_delay_us = parse_uint32(name, value);
+    } else if (name == "--cache-entries") {
+      options.cache_entries = parse_uint32(name, value);
+    } else if (name == "--seed") {
+      options.seed = parse_uint(name, value);
+    } else {
+      throw std::invalid_argument("unknown option: " + arg);
+    }
+  }
+
+  if (batch_size > 0) {
+    options.shape[0] = batch_size;
+  }
+
+  if (options.concurrency == 0 || options.distinct_inputs == 0 || options.rate < 0.0) {
+    throw std::invalid_argument("--concurrency and --distinct-inputs must be positive, --rate non-negative");
+  }
+
+  if (options.instances == 0 || options.threads == 0) {
+    throw std::invalid_argument("--instances and --threads must be positive");
+  }
+
+  return options;
+}
+
+std::vector<Tensor> make_inputs(const Options &options) {
+  size_t size = 1;
+  for (std::uint32_t dim : options.shape) {
+    size *= dim;
+  }
+
+  std::vector<Tensor> inputs(options.distinct_inputs);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i].shape = options.shape;
+    inputs[i].data.assign(size, static_cast<float>(i));
+  }
+  return inputs;
+}
+
+// scheduled arrival offsets of the measured requests (open loop only)
+std::vector<Clock::duration> make_schedule(const Options &options) {
+  std::vector<Clock::duration> schedule(options.requests);
+  if (options.rate <= 0.0) {
+    return schedule;
+  }
+
+  std::mt19937_64 rng{options.seed};
+  std::exponential_distribution<double> gap{options.rate};
+
+  double seconds = 0.0;
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    schedule[i] = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    seconds += options.poisson ? gap(rng) : 1.0 / options.rate;
+  }
+  return schedule;
+}
+
+std::uint64_t to_ns(Clock::duration duration) {
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+double to_us(std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+
+std::string summary_json(const core::LatencySnapshot &snapshot) {
+  std::ostringstream out;
+  out << "{\"count\": " << snapshot.count << ", \"mean\": " << to_us(static_cast<std::uint64_t>(snapshot.mean()))
+      << ", \"min\": " << to_us(snapshot.min) << ", \"p50\": " << to_us(snapshot.quantile(0.5))
+      << ", \"p90\": " << to_us(snapshot.quantile(0.9)) << ", \"p99\": " << to_us(snapshot.quantile(0.99))
+      << ", \"p999\": " << to_us(snapshot.quantile(0.999)) << ", \"max\": " << to_us(snapshot.max) << "}";
+  return out.str();
+}
+
+// latency CDF as [upper bound in us, cumulative fraction] of every non-empty bucket
+std::string cdf_json(const core::LatencySnapshot &snapshot) {
+  std::ostringstream out;
+  out << "[";
+
+  std::uint64_t seen = 0;
+  bool first = true;
+  for (size_t i = 0; i < snapshot.counts.size(); ++i) {
+    if (snapshot.counts[i] == 0) {
+      continue;
+    }
+
+    seen += snapshot.counts[i];
+    out << (first ? "" : ", ") << "[" << to_us(core::LatencyHistogram::bucket_upper(i)) << ", "
+        << static_cast<double>(seen) / static_cast<double>(snapshot.count) << "]";
+    first = false;
+  }
+
+  out << "]";
+  return out.str();
+}
+
+std::string shape_json(const Shape &shape) {
+  std::ostringstream out;
+  out << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    out << (i > 0 ? ", " : "") << shape[i];
+  }
+  out << "]";
+  return out.str();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "load_generator: " << e.what() << "\n";
+    print_usage();
+    return 2;
+  }
+
+  ModelConfig config;
+  config.device = "MOCK";
+  config.cache.max_entries = options.cache_entries;
+  config.batching.max_batch_size = options.max_batch_size;
+  config.batching.max_delay = std::chrono::microseconds{options.max_delay_us};
+
+  config.execution = {.threads = options.threads, .instances = options.instances};
+
+  // one MockBackend per instance, simulating the configured thread count (as the MOCK device)
+  std::mutex backends_mutex;
+  std::vector<const MockBackend *> backends;
+  Context context{std::move(config), [&](const ModelConfig &model) {
+                    MockConfig mock = options.mock;
+                    mock.threads = model.execution.threads;
+                    auto backend = std::make_unique<MockBackend>(mock);
+
+                    std::scoped_lock lock{backends_mutex};
+                    backends.push_back(backend.get());
+                    return backend;
+                  }};
+
+  // predict calls and samples summed over all instances
+  const auto backend_totals = [&backends] {
+    std::pair<std::uint64_t, std::uint64_t> totals{0, 0};
+    for (const MockBackend *backend : backends) {
+      totals.first += backend->predict_calls();
+      totals.second += backend->samples();
+    }
+    return totals;
+  };
+
+  const auto inputs = make_inputs(options);
+  const auto schedule = make_schedule(options);
+  const bool open_loop = options.rate > 0.0;
+
+  // runs on_request(0..count) from `concurrency` client threads
+  const auto drive = [&](std::uint64_t count, const auto &on_request) {
+    std::atomic<std::uint64_t> next{0};
+    std::vector<std::thread> clients;
+
+    for (std::uint32_t c = 0; c < options.concurrency; ++c) {
+      clients.emplace_back([&] {
+        for (std::uint64_t i = next++; i < count; i = next++) {
+          on_request(i);
+        }
+      });
+    }
+
+    for (auto &client : clients) {
+      client.join();
+    }
+  };
+
+  // warmup: same concurrency, closed loop, not measured
+  drive(options.warmup, [&](std::uint64_t i) {
+    const Tensor &input = inputs[i % inputs.size()];
+    context.run(TensorView{.shape = input.shape, .data = input.data});
+  });
+
+  context.reset_latency_stats();
+  const auto [warm_predict_calls, warm_samples] = backend_totals();
+
+  core::LatencyHistogram latency;      // scheduled (open loop) or issue (closed loop) time to completion
+  core::LatencyHistogram client_queue; // scheduled time to issue, open loop only
+  std::atomic<std::uint64_t> errors{0};
+
+  const auto start = Clock::now();
+
+  drive(options.requests, [&](std::uint64_t i) {
+    auto issued = Clock::now();
+    auto scheduled = issued;
+
+    if (open_loop) {
+      scheduled = start + schedule[i];
+      std::this_thread::sleep_until(scheduled);
+      issued = Clock::now();
+      client_queue.record(to_ns(issued - scheduled));
+    }
+
+    const Tensor &input = inputs[i % inputs.size()];
+    try {
+      context.run(TensorView{.shape = input.shape, .data = input.data});
+    } catch (const std::exception &) {
+      errors++;
+      return;
+    }
+
+    latency.record(to_ns(Clock::now() - scheduled));
+  });
+
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const auto stats = context.latency_stats();
+  const auto result = latency.snapshot();
+  const auto [total_predict_calls, total_samples] = backend_totals();
+  const auto predict_calls = total_predict_calls - warm_predict_calls;
+  const auto samples = total_samples - warm_samples;
+  const double sample_size = options.shape.empty() ? 1.0 : static_cast<double>(options.shape[0]);
+
+  std::cout << "{\n"
+            << "  \"config\": {\"mode\": \"" << (open_loop ? "open" : "closed") << "\", \"concurrency\": "
+            << options.concurrency << ", \"rate\": " << options.rate
+            << ", \"poisson\": " << (options.poisson ? "true" : "false") << ", \"requests\": " << options.requests
+            << ", \"shape\": " << shape_json(options.shape) << ", \"instances\": " << options.instances
+            << ", \"threads\": " << options.threads << ", \"parallel_fraction\": " << options.mock.parallel_fraction
+            << ", \"max_batch_size\": " << options.max_batch_size
+            << ", \"max_delay_us\": " << options.max_delay_us
+            << ", \"predict_cost_us\": " << options.mock.predict_cost.count()
+            << ", \"sample_cost_us\": " << options.mock.sample_cost.count()
+            << ", \"cache_entries\": " << options.cache_entries << "},\n"
+            << "  \"duration_s\": " << seconds << ",\n"
+            << "  \"completed\": " << result.count << ",\n"
+            << "  \"errors\": " << errors.load() << ",\n"
+            << "  \"throughput_rps\": " << static_cast<double>(result.count) / seconds << ",\n"
+            << "  \"samples_per_s\": " << static_cast<double>(result.count) * sample_size / seconds << ",\n"
+            << "  \"latency_us\": " << summary_json(result) << ",\n"
+            << "  \"breakdown_us\": {\n"
+            << "    \"client_queue\": " << summary_json(client_queue.snapshot()) << ",\n"
+            << "    \"context_run\": " << summary_json(stats.run) << ",\n"
+            << "    \"context_queue\": " << summary_json(stats.queue_wait) << ",\n"
+            << "    \"predict\": " << summary_json(stats.predict) << "\n"
+            << "  },\n"
+            << "  \"backend\": {\"predict_calls\": " << predict_calls << ", \"samples\": " << samples
+            << ", \"mean_batch_size\": "
+            << (predict_calls > 0 ? static_cast<double>(samples) / static_cast<double>(predict_calls) : 0.0) << "},\n"
+            << "  \"latency_cdf_us\": " << cdf_json(result) << "\n"
+            << "}\n";
+
+  return errors.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
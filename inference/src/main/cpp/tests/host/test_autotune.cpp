@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inference/autotune.hpp"
+#include "inference/mock_backend.hpp"
+
+#include "common/mock_context.hpp"
+
+using namespace inference;
+using inference::core::TunedConfig;
+using inference::core::TuningStore;
+using inference::test::make_mock_pool;
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / ("inference_" + name + ".tuning")).string();
+}
+
+std::unique_ptr<Context> make_context(MockConfig mock) {
+  ModelConfig config;
+  config.batching.max_delay = std::chrono::microseconds{500};
+  return make_mock_pool(std::move(config), mock);
+}
+
+// per-sample cost dominates: batch 8 has more throughput but ~401 ms latency (~51 ms unbatched).
+// The gaps to the SLOs used with it are ~150 ms, so scheduling noise of a loaded host cannot flip them.
+std::unique_ptr<Context> make_sample_bound_context() {
+  return make_context({.output_size = 4,
+                       .predict_cost = std::chrono::milliseconds{1},
+                       .sample_cost = std::chrono::milliseconds{50},
+                       .input_shape = {1, 4}});
+}
+
+AutotuneConfig tune_batch_sizes(std::chrono::microseconds target_p99) {
+  AutotuneConfig config;
+  config.target_p99 = target_p99;
+  config.threads = {1};
+  config.instances = {1};
+  config.batch_sizes = {1, 8};
+  config.requests = 32;
+  config.warmup = 8;
+  return config;
+}
+
+} // namespace
+
+TEST(AutotuneTests, CandidatesRespectCoreCount) {
+  AutotuneConfig config;
+  config.instances = {1, 2};
+  config.batch_sizes = {1};
+
+  const auto candidates = autotune_candidates(config, std::chrono::microseconds{100}, 4);
+
+  // threads 1, 2, 4 with one instance; 1, 2 with two
+  ASSERT_EQ(candidates.size(), 5);
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const auto &execution = candidates[i].execution;
+    EXPECT_LE(execution.threads * execution.instances, 4);
+    if (i > 0) {
+      const auto &previous = candidates[i - 1].execution;
+      EXPECT_LE(previous.threads * previous.instances, execution.threads * execution.instances);
+    }
+  }
+}
+
+TEST(AutotuneTests, PicksHighestThroughputWithinSlo) {
+  // batching amortizes the per-call cost: batch 8 serves ~8x more runs at similar latency
+  auto context =
+      make_context({.output_size = 4, .predict_cost = std::chrono::microseconds{1000}, .input_shape = {1, 4}});
+
+  const auto result = autotune(*context, tune_batch_sizes(std::chrono::seconds{1}));
+
+  ASSERT_EQ(result.trials.size(), 2);
+  EXPECT_TRUE(result.best.meets_slo);
+  EXPECT_EQ(result.best.batching.max_batch_size, 8);
+  EXPECT_GT(result.trials[1].throughput, result.trials[0].throughput);
+  EXPECT_EQ(context->config().batching.max_batch_size, 8);
+}
+
+TEST(AutotuneTests, SloExcludesFasterConfigs) {
+  auto context = make_sample_bound_context();
+
+  auto config = tune_batch_sizes(std::chrono::milliseconds{200});
+  config.requests = 16;
+  const auto result = autotune(*context, config);
+
+  ASSERT_EQ(result.trials.size(), 2);
+  EXPECT_TRUE(result.trials[0].meets_slo);
+  EXPECT_FALSE(result.trials[1].meets_slo);
+  EXPECT_EQ(result.best.batching.max_batch_size, 1);
+  EXPECT_FALSE(context->config().batching.enabled());
+}
+
+TEST(AutotuneTests, UnreachableSloPicksLowestLatency) {
+  auto context = make_sample_bound_context();
+
+  auto config = tune_batch_sizes(std::chrono::microseconds{1});
+  config.requests = 16;
+  const auto result = autotune(*context, config);
+
+  EXPECT_FALSE(result.best.meets_slo);
+  EXPECT_EQ(result.best.batching.max_batch_size, 1);
+}
+
+TEST(AutotuneTests, RequiresInputShapeAndFactory) {
+  auto context = make_context({.output_size = 4});
+  EXPECT_THROW(autotune(*context, tune_batch_sizes(std::chrono::seconds{1})), std::invalid_argument);
+
+  Context fixed({}, std::make_unique<MockBackend>(MockConfig{.output_size = 4, .input_shape = {1, 4}}));
+  EXPECT_THROW(autotune(fixed, tune_batch_sizes(std::chrono::seconds{1})), std::logic_error);
+}
+
+TEST(AutotuneTests, ModelHashDependsOnContent) {
+  const std::vector<std::uint8_t> a{1, 2, 3};
+  const std::vector<std::uint8_t> b{1, 2, 4};
+
+  ModelConfig first;
+  first.model_data = a;
+  ModelConfig second;
+  second.model_data = b;
+
+  EXPECT_NE(model_hash(first), model_hash(second));
+  EXPECT_EQ(model_hash(first), model_hash(first));
+  EXPECT_NE(core::tuning_key(model_hash(first)), core::tuning_key(model_hash(second)));
+  EXPECT_NE(core::tuning_key(1, "4:0,0,0,0"), core::tuning_key(1, "8:0,0,0,0,0,0,0,0"));
+}
+
+TEST(CoreTuningStoreTests, RoundTrip) {
+  const auto path = temp_path("round_trip");
+  std::filesystem::remove(path);
+
+  const TuningStore store{path};
+  EXPECT_FALSE(store.load("model@4:0").has_value());
+
+  const TunedConfig a{.threads = 2, .instances = 1, .max_batch_size = 8, .max_delay_us = 500};
+  const TunedConfig b{.threads = 1, .instances = 2, .max_batch_size = 1, .max_delay_us = 2000};
+  store.save("a@4:0", a);
+  store.save("b@4:0", b);
+
+  EXPECT_EQ(TuningStore{path}.load("a@4:0"), a);
+  EXPECT_EQ(TuningStore{path}.load("b@4:0"), b);
+
+  // saving an existing key replaces it
+  store.save("a@4:0", b);
+  EXPECT_EQ(store.load("a@4:0"), b);
+  EXPECT_EQ(store.load("b@4:0"), b);
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTuningStoreTests, SkipsInvalidEntries) {
+  const auto path = temp_path("invalid_entries");
+  {
+    std::ofstream out{path, std::ios::trunc};
+    out << "zero_threads 0 1 8 500\n"
+        << "zero_instances 1 0 8 500\n"
+        << "zero_batch 1 1 0 500\n"
+        << "negative -1 1 8 500\n"
+        << "negative_delay 1 1 8 -1\n"
+        << "truncated 1 1\n"
+        << "valid 2 1 4 500\n";
+  }
+
+  const TuningStore store{path};
+  for (const char *key : {"zero_threads", "zero_instances", "zero_batch", "negative", "negative_delay", "truncated"}) {
+    EXPECT_FALSE(store.load(key).has_value()) << key;
+  }
+  EXPECT_EQ(store.load("valid"), (TunedConfig{.threads = 2, .instances = 1, .max_batch_size = 4, .max_delay_us = 500}));
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTuningStoreTests, CpuTopologyListsCores) {
+  const auto topology = core::cpu_topology();
+  ASSERT_NE(topology.find(':'), std::string::npos);
+  EXPECT_EQ(std::stoul(topology.substr(0, topology.find(':'))), std::max(1U, std::thread::hardware_concurrency()));
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "inference/batch_runner.hpp"
+#include "inference/mock_backend.hpp"
+
+#include "common/mock_context.hpp"
+
+using namespace inference;
+using namespace inference::test;
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / ("inference_" + name + ".tds")).string();
+}
+
+// records [1, 2, 2] filled with their index
+void write_dataset(const std::string &path, std::uint32_t records) {
+  core::TensorDatasetWriter writer{path};
+  for (std::uint32_t i = 0; i < records; i++) {
+    const std::vector<float> data(4, static_cast<float>(i));
+    writer.append(data, {1, 2, 2});
+  }
+  writer.finish();
+}
+
+} // namespace
+
+TEST(BatchRunnerTests, WritesOutputsInOrder) {
+  const auto input_path = temp_path("runner_in");
+  const auto output_path = temp_path("runner_out");
+  write_dataset(input_path, 23);
+
+  auto [backend, context] = make_mock_context();
+  const core::TensorDataset input{input_path};
+
+  BatchRunnerStats stats;
+  {
+    core::TensorDatasetWriter output{output_path};
+    stats = BatchRunner{*context, {.batch_size = 4, .workers = 3, .prefetch = 2}}.run(input, output);
+    output.finish();
+  }
+
+  EXPECT_EQ(stats.records, 23);
+  EXPECT_EQ(stats.batches, 6);
+  EXPECT_EQ(backend->predict_calls(), 6); // 5 full batches and a batch of 3
+  EXPECT_EQ(backend->samples(), 23);
+
+  const core::TensorDataset output{output_path};
+  ASSERT_EQ(output.size(), 23);
+
+  for (size_t i = 0; i < output.size(); i++) {
+    const auto record = output.record(i);
+    EXPECT_EQ(record.shape, (Shape{1, 4}));
+    EXPECT_FLOAT_EQ(record.floats()[0], static_cast<float>(i));
+    EXPECT_FLOAT_EQ(record.floats()[3], static_cast<float>(i + 3));
+  }
+
+  std::filesystem::remove(input_path);
+  std::filesystem::remove(output_path);
+}
+
+TEST(BatchRunnerTests, RaggedRecordsRunOneByOne) {
+  const auto input_path = temp_path("runner_ragged_in");
+  const auto output_path = temp_path("runner_ragged_out");
+
+  {
+    core::TensorDatasetWriter writer{input_path};
+    writer.append(std::vector<float>(4, 1.0F), {1, 4});
+    writer.append(std::vector<float>(8, 2.0F), {2, 4});
+    writer.finish();
+  }
+
+  auto [backend, context] = make_mock_context();
+  const core::TensorDataset input{input_path};
+  {
+    core::TensorDatasetWriter output{output_path};
+    BatchRunner{*context, {.batch_size = 2}}.run(input, output);
+    output.finish();
+  }
+
+  EXPECT_EQ(backend->predict_calls(), 2);
+
+  const core::TensorDataset output{output_path};
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(output.record(1).shape, (Shape{2, 4}));
+  EXPECT_FLOAT_EQ(output.record(1).floats()[4], 2.0F);
+
+  std::filesystem::remove(input_path);
+  std::filesystem::remove(output_path);
+}
+
+TEST(BatchRunnerTests, RecordsWithoutUnitBatchRunOneByOne) {
+  const auto input_path = temp_path("runner_unbatched_in");
+  const auto output_path = temp_path("runner_unbatched_out");
+
+  // same shapes, but [2, 4] and [4] records have no leading batch dimension of 1 to stack along
+  {
+    core::TensorDatasetWriter writer{input_path};
+    writer.append(std::vector<float>(8, 1.0F), {2, 4});
+    writer.append(std::vector<float>(8, 2.0F), {2, 4});
+    writer.append(std::vector<float>(4, 3.0F), {4});
+    writer.append(std::vector<float>(4, 4.0F), {4});
+    writer.finish();
+  }
+
+  auto [backend, context] = make_mock_context();
+  const core::TensorDataset input{input_path};
+  {
+    core::TensorDatasetWriter output{output_path};
+    BatchRunner{*context, {.batch_size = 2}}.run(input, output);
+    output.finish();
+  }
+
+  EXPECT_EQ(backend->predict_calls(), 4);
+
+  const core::TensorDataset output{output_path};
+  ASSERT_EQ(output.size(), 4);
+  EXPECT_EQ(output.record(0).shape, (Shape{2, 4}));
+  EXPECT_FLOAT_EQ(output.record(1).floats()[0], 2.0F);
+
+  std::filesystem::remove(input_path);
+  std::filesystem::remove(output_path);
+}
+
+TEST(BatchRunnerTests, WritesTopK) {
+  const auto input_path = temp_path("runner_topk_in");
+  const auto output_path = temp_path("runner_topk_out");
+  write_dataset(input_path, 3);
+
+  auto [backend, context] = make_mock_context({}, {.output_size = 10});
+  const core::TensorDataset input{input_path};
+  {
+    core::TensorDatasetWriter output{output_path};
+    BatchRunner{*context, {.batch_size = 2, .workers = 2, .top_k = 3}}.run(input, output);
+    output.finish();
+  }
+
+  const core::TensorDataset output{output_path};
+  ASSERT_EQ(output.size(), 6); // (labels, scores) per record
+
+  for (size_t i = 0; i < 3; i++) {
+    const auto labels = output.record(i * 2);
+    const auto scores = output.record(i * 2 + 1);
+
+    ASSERT_EQ(labels.dtype, core::types::DataType::INT32);
+    EXPECT_EQ(labels.shape, (Shape{1, 3}));
+
+    // mock output is mean + j: the best classes are the last ones
+    const auto *label_data = reinterpret_cast<const std::int32_t *>(labels.bytes.data());
+    EXPECT_EQ(std::vector<std::int32_t>(label_data, label_data + 3), (std::vector<std::int32_t>{9, 8, 7}));
+    EXPECT_FLOAT_EQ(scores.floats()[0], static_cast<float>(i + 9));
+  }
+
+  std::filesystem::remove(input_path);
+  std::filesystem::remove(output_path);
+}
+
+TEST(BatchRunnerTests, PropagatesErrors) {
+  const auto input_path = temp_path("runner_error_in");
+  const auto output_path = temp_path("runner_error_out");
+
+  {
+    core::TensorDatasetWriter writer{input_path};
+    writer.append(std::vector<float>(4, 1.0F), {1, 4});
+    writer.append(std::vector<std::uint8_t>(4, 1), {1, 4}, core::types::Layout::UNDEFINED,
+                  core::types::DataType::UINT8);
+    writer.finish();
+  }
+
+  auto [backend, context] = make_mock_context();
+  const core::TensorDataset input{input_path};
+  {
+    core::TensorDatasetWriter output{output_path};
+    EXPECT_THROW(BatchRunner(*context, {.batch_size = 1, .workers = 2}).run(input, output), std::runtime_error);
+  }
+  EXPECT_THROW(BatchRunner(*context, {.batch_size = 0}), std::invalid_argument);
+
+  // the aborted run leaves an unfinished output that readers refuse, not a valid prefix
+  EXPECT_THROW(core::TensorDataset{output_path}, std::runtime_error);
+
+  std::filesystem::remove(input_path);
+  std::filesystem::remove(output_path);
+}
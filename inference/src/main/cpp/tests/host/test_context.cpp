@@ -0,0 +1,378 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "inference/context.hpp"
+#include "inference/mock_backend.hpp"
+
+#include "common/mock_context.hpp"
+
+using namespace inference;
+using namespace inference::test;
+
+namespace {
+
+Tensor make_input(float value, std::uint32_t batch = 1) {
+  Tensor tensor;
+  tensor.shape = {batch, 3, 2, 2};
+  tensor.data.assign(batch * 12, value);
+  return tensor;
+}
+
+class FailingBackend final : public Backend {
+public:
+  Tensor predict(const TensorView & /*in*/) override { throw std::runtime_error("predict failed"); }
+};
+
+// tracks how many predicts of all instances overlap
+struct Overlap {
+  std::atomic<int> in_flight{0};
+  std::atomic<int> max_in_flight{0};
+};
+
+class OverlapBackend final : public Backend {
+public:
+  explicit OverlapBackend(Overlap &overlap) : overlap_{overlap} {}
+
+  Tensor predict(const TensorView &in) override {
+    const int now = overlap_.in_flight.fetch_add(1) + 1;
+    int max = overlap_.max_in_flight.load();
+    while (now > max && !overlap_.max_in_flight.compare_exchange_weak(max, now)) {
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    overlap_.in_flight.fetch_sub(1);
+    return {.shape = in.shape, .data = {in.data.begin(), in.data.end()}};
+  }
+
+private:
+  Overlap &overlap_;
+};
+
+void run_concurrently(Context &context, int count) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < count; i++) {
+    threads.emplace_back([&] {
+      const auto input = make_input(1.0F);
+      context.run(as_view(input));
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+TEST(ContextTests, RunsBackend) {
+  auto [backend, context] = make_mock_context({});
+  const auto input = make_input(2.0F);
+
+  const auto out = context->run(as_view(input));
+
+  EXPECT_EQ(out.shape, (Shape{1, 4}));
+  EXPECT_EQ(out.data, (std::vector<float>{2.0F, 3.0F, 4.0F, 5.0F}));
+  EXPECT_EQ(backend->predict_calls(), 1);
+}
+
+TEST(ContextTests, RequiresBackend) { EXPECT_THROW(Context({}, nullptr), std::invalid_argument); }
+
+TEST(ContextTests, ReturnsNamedOutput) {
+  ModelConfig config;
+  config.output_name = "embedding";
+  const auto context = make_mock_pool(config, {.output_size = 4});
+  const auto input = make_input(2.0F);
+
+  const auto out = context->run(as_view(input));
+
+  EXPECT_EQ(out.shape, (Shape{1, 4}));
+  EXPECT_EQ(out.data, (std::vector<float>{-2.0F, -3.0F, -4.0F, -5.0F}));
+
+  // like a real model, an unknown output name fails when the backend is built
+  config.output_name = "missing";
+  EXPECT_THROW(make_mock_pool(config, {.output_size = 4}), std::runtime_error);
+}
+
+TEST(ContextTests, CacheHitSkipsPredict) {
+  ModelConfig config;
+  config.cache.max_entries = 8;
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  const auto a = make_input(1.0F);
+  const auto b = make_input(5.0F);
+
+  const auto first = context->run(as_view(a));
+  const auto second = context->run(as_view(a));
+  context->run(as_view(b));
+
+  EXPECT_EQ(first.data, second.data);
+  EXPECT_EQ(backend->predict_calls(), 2);
+
+  const auto stats = context->cache_stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.entries, 2);
+}
+
+TEST(ContextTests, CacheDisabledByDefault) {
+  auto [backend, context] = make_mock_context({});
+  const auto input = make_input(1.0F);
+
+  context->run(as_view(input));
+  context->run(as_view(input));
+
+  EXPECT_EQ(backend->predict_calls(), 2);
+  EXPECT_EQ(context->cache_stats().misses, 0);
+}
+
+TEST(ContextTests, BatchingCoalescesConcurrentRuns) {
+  constexpr int kRequests = 4;
+
+  ModelConfig config;
+  config.batching.max_batch_size = kRequests;
+  config.batching.max_delay = std::chrono::seconds{10}; // dispatch only on a full batch
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  std::vector<Tensor> outputs(kRequests);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < kRequests; i++) {
+    threads.emplace_back([&, i] {
+      const auto input = make_input(static_cast<float>(i * 10));
+      outputs[i] = context->run(as_view(input));
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(backend->predict_calls(), 1);
+  EXPECT_EQ(backend->samples(), kRequests);
+
+  // each caller gets its own sample back
+  for (int i = 0; i < kRequests; i++) {
+    EXPECT_EQ(outputs[i].shape, (Shape{1, 4}));
+    EXPECT_FLOAT_EQ(outputs[i].data[0], static_cast<float>(i * 10));
+  }
+}
+
+TEST(ContextTests, BatchingFlushesAfterMaxDelay) {
+  ModelConfig config;
+  config.batching.max_batch_size = 8;
+  config.batching.max_delay = std::chrono::milliseconds{1};
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  const auto input = make_input(3.0F);
+  const auto out = context->run(as_view(input));
+
+  EXPECT_FLOAT_EQ(out.data[0], 3.0F);
+  EXPECT_EQ(backend->predict_calls(), 1);
+}
+
+TEST(ContextTests, BatchingCountsOnlyRequestsOfTheSameShape) {
+  ModelConfig config;
+  config.batching.max_batch_size = 2;
+  config.batching.max_delay = std::chrono::milliseconds{300};
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  // a, other, b arrive in this order; a and b share a shape, so `other` must not complete a's batch
+  const auto a = make_input(1.0F);
+  const Tensor other{.shape = {1, 4}, .data = std::vector<float>(4, 2.0F)};
+  const auto b = make_input(3.0F);
+
+  std::vector<std::thread> threads;
+  for (const Tensor *input : {&a, &other, &b}) {
+    threads.emplace_back([&context, input] { context->run(as_view(*input)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // {a, b} as one batch and `other` alone after max_delay
+  EXPECT_EQ(backend->samples(), 3);
+  EXPECT_EQ(backend->predict_calls(), 2);
+}
+
+TEST(ContextTests, BatchingBypassesMultiSampleInputs) {
+  ModelConfig config;
+  config.batching.max_batch_size = 8;
+  config.batching.max_delay = std::chrono::seconds{10};
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  const auto input = make_input(1.0F, 2);
+  const auto out = context->run(as_view(input));
+
+  EXPECT_EQ(out.shape, (Shape{2, 4}));
+  EXPECT_EQ(backend->predict_calls(), 1);
+}
+
+TEST(ContextTests, BatchingPropagatesErrors) {
+  ModelConfig config;
+  config.batching.max_batch_size = 2;
+  config.batching.max_delay = std::chrono::seconds{10};
+  Context context{std::move(config), std::make_unique<FailingBackend>()};
+
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+
+  for (int i = 0; i < 2; i++) {
+    threads.emplace_back([&] {
+      const auto input = make_input(1.0F);
+      try {
+        context.run(as_view(input));
+      } catch (const std::runtime_error &) {
+        failures++;
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(failures.load(), 2);
+}
+
+TEST(ContextTests, RecordsLatencyStats) {
+  ModelConfig config;
+  config.cache.max_entries = 8;
+  auto [backend, context] =
+      make_mock_context(std::move(config), {.output_size = 4, .predict_cost = std::chrono::milliseconds{1}});
+
+  const auto input = make_input(1.0F);
+  context->run(as_view(input));
+  context->run(as_view(input)); // cache hit: no queue wait or predict
+
+  const auto stats = context->latency_stats();
+  EXPECT_EQ(stats.run.count, 2);
+  EXPECT_EQ(stats.queue_wait.count, 1);
+  EXPECT_EQ(stats.predict.count, 1);
+  EXPECT_GE(stats.predict.min, 1000000);
+  EXPECT_GE(stats.run.max, stats.predict.max);
+
+  context->reset_latency_stats();
+  EXPECT_EQ(context->latency_stats().run.count, 0);
+}
+
+TEST(ContextTests, BatchingRecordsQueueWaitPerRequest) {
+  constexpr int kRequests = 4;
+
+  ModelConfig config;
+  config.batching.max_batch_size = kRequests;
+  config.batching.max_delay = std::chrono::seconds{10};
+  auto [backend, context] = make_mock_context(std::move(config));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kRequests; i++) {
+    threads.emplace_back([&] {
+      const auto input = make_input(1.0F);
+      context->run(as_view(input));
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = context->latency_stats();
+  EXPECT_EQ(stats.run.count, kRequests);
+  EXPECT_EQ(stats.queue_wait.count, kRequests);
+  EXPECT_EQ(stats.predict.count, 1);
+}
+
+TEST(ContextTests, DetectRequiresConfig) {
+  auto [backend, context] = make_mock_context({});
+  const auto input = make_input(0.0F);
+  EXPECT_THROW(context->detect(as_view(input)), std::runtime_error);
+}
+
+TEST(ContextTests, DetectPostprocessesOutput) {
+  ModelConfig config;
+  config.detection.emplace();
+  config.detection->num_classes = 2;
+  config.detection->box_format = core::BoxFormat::CORNERS;
+
+  // mock output row: (0, 1, 2, 3 | 4, 5) for an all-zero input
+  auto [backend, context] = make_mock_context(std::move(config), {.output_size = 6});
+  const auto input = make_input(0.0F);
+
+  const auto detections = context->detect(as_view(input));
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections.labels[0], 1);
+  EXPECT_FLOAT_EQ(detections.scores[0], 5.0F);
+  EXPECT_EQ(detections.boxes, (std::vector<float>{0, 1, 2, 3}));
+}
+
+TEST(ContextTests, DetectRejectsBatchedInput) {
+  ModelConfig config;
+  config.detection.emplace();
+  config.detection->num_classes = 2;
+
+  auto [backend, context] = make_mock_context(std::move(config), {.output_size = 6});
+  const auto input = make_input(0.0F, 2);
+
+  // rows of different images must not suppress each other in one NMS
+  EXPECT_THROW(context->detect(as_view(input)), std::invalid_argument);
+  EXPECT_EQ(backend->predict_calls(), 0);
+}
+
+TEST(ContextTests, InstancesPredictConcurrently) {
+  Overlap overlap;
+  std::atomic<int> built{0};
+
+  ModelConfig config;
+  config.execution.instances = 2;
+  Context context(std::move(config), [&](const ModelConfig &) {
+    built++;
+    return std::make_unique<OverlapBackend>(overlap);
+  });
+
+  run_concurrently(context, 4);
+
+  EXPECT_EQ(built.load(), 2);
+  EXPECT_EQ(overlap.max_in_flight.load(), 2);
+}
+
+TEST(ContextTests, FixedBackendPredictsSerially) {
+  Overlap overlap;
+  Context context({}, std::make_unique<OverlapBackend>(overlap));
+
+  run_concurrently(context, 3);
+
+  EXPECT_EQ(overlap.max_in_flight.load(), 1);
+  EXPECT_FALSE(context.reconfigurable());
+  EXPECT_THROW(context.reconfigure({}, {}), std::logic_error);
+}
+
+TEST(ContextTests, ReconfigureRebuildsBackends) {
+  std::vector<std::uint32_t> threads;
+
+  Context context({}, [&](const ModelConfig &model) {
+    threads.push_back(model.execution.threads);
+    return std::make_unique<MockBackend>(MockConfig{.output_size = 4});
+  });
+
+  context.reconfigure({.threads = 2, .instances = 3},
+                      {.max_batch_size = 4, .max_delay = std::chrono::microseconds{100}});
+
+  EXPECT_EQ(threads, (std::vector<std::uint32_t>{1, 2, 2, 2}));
+  EXPECT_EQ(context.config().execution.instances, 3);
+  EXPECT_EQ(context.config().batching.max_batch_size, 4);
+
+  const auto input = make_input(2.0F);
+  EXPECT_EQ(context.run(as_view(input)).data, (std::vector<float>{2.0F, 3.0F, 4.0F, 5.0F}));
+
+  // invalid configs are rejected before anything changes
+  EXPECT_THROW(context.reconfigure({.threads = 1, .instances = 0}, {}), std::invalid_argument);
+  EXPECT_EQ(context.config().execution.instances, 3);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/core/detection.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+// rows of (x1, y1, x2, y2, class0, class1)
+DetectionConfig corners_config() {
+  DetectionConfig config;
+  config.num_classes = 2;
+  config.box_format = BoxFormat::CORNERS;
+  config.score_threshold = 0.3F;
+  config.iou_threshold = 0.5F;
+  return config;
+}
+
+float logit(float p) { return std::log(p / (1.0F - p)); }
+
+} // namespace
+
+TEST(CoreDetectionTests, EmptyInput) {
+  const auto detections = postprocess_detections({}, 0, corners_config());
+  EXPECT_EQ(detections.size(), 0);
+}
+
+TEST(CoreDetectionTests, ScoreThreshold) {
+  const std::vector<float> rows = {
+      0, 0, 10, 10, 0.9F, 0.1F, //
+      20, 20, 30, 30, 0.2F, 0.1F,
+  };
+
+  const auto detections = postprocess_detections(rows, 2, corners_config());
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_FLOAT_EQ(detections.scores[0], 0.9F);
+  EXPECT_EQ(detections.labels[0], 0);
+  EXPECT_EQ(detections.boxes, (std::vector<float>{0, 0, 10, 10}));
+}
+
+TEST(CoreDetectionTests, SuppressesOverlapsWithinClass) {
+  const std::vector<float> rows = {
+      0, 0, 10, 10, 0.8F, 0.0F,  // kept
+      1, 1, 11, 11, 0.9F, 0.0F,  // kept (best), overlaps the first
+      50, 50, 60, 60, 0.7F, 0.0F, // kept, disjoint
+  };
+
+  const auto detections = postprocess_detections(rows, 3, corners_config());
+
+  ASSERT_EQ(detections.size(), 2);
+  EXPECT_FLOAT_EQ(detections.scores[0], 0.9F);
+  EXPECT_FLOAT_EQ(detections.scores[1], 0.7F);
+}
+
+TEST(CoreDetectionTests, ClassWiseVersusAgnostic) {
+  const std::vector<float> rows = {
+      0, 0, 10, 10, 0.9F, 0.0F, //
+      0, 0, 10, 10, 0.0F, 0.8F,
+  };
+
+  auto config = corners_config();
+  EXPECT_EQ(postprocess_detections(rows, 2, config).size(), 2);
+
+  config.class_agnostic = true;
+  const auto detections = postprocess_detections(rows, 2, config);
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections.labels[0], 0);
+}
+
+TEST(CoreDetectionTests, MaxDetections) {
+  std::vector<float> rows;
+  for (int i = 0; i < 10; i++) {
+    const auto x = static_cast<float>(i * 20);
+    rows.insert(rows.end(), {x, 0, x + 10, 10, 0.5F + 0.01F * static_cast<float>(i), 0.0F});
+  }
+
+  auto config = corners_config();
+  config.max_detections = 3;
+
+  const auto detections = postprocess_detections(rows, 10, config);
+  ASSERT_EQ(detections.size(), 3);
+  EXPECT_FLOAT_EQ(detections.scores[0], 0.59F);
+  EXPECT_FLOAT_EQ(detections.boxes[0], 180.0F);
+}
+
+TEST(CoreDetectionTests, MultiLabel) {
+  const std::vector<float> rows = {0, 0, 10, 10, 0.9F, 0.6F};
+
+  auto config = corners_config();
+  config.multi_label = true;
+
+  const auto detections = postprocess_detections(rows, 1, config);
+  ASSERT_EQ(detections.size(), 2);
+  EXPECT_EQ(detections.labels, (std::vector<uint32_t>{0, 1}));
+}
+
+TEST(CoreDetectionTests, ObjectnessAndSigmoid) {
+  // YOLO-style row: (cx, cy, w, h, objectness, class0, class1) as logits
+  const std::vector<float> rows = {
+      5, 5, 10, 10, logit(0.9F), logit(0.2F), logit(0.8F), //
+      50, 50, 10, 10, logit(0.1F), logit(0.99F), logit(0.0F + 0.01F),
+  };
+
+  DetectionConfig config;
+  config.num_classes = 2;
+  config.objectness_offset = 4;
+  config.class_offset = 5;
+  config.sigmoid = true;
+  config.score_threshold = 0.5F;
+
+  const auto detections = postprocess_detections(rows, 2, config);
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections.labels[0], 1);
+  EXPECT_NEAR(detections.scores[0], 0.72F, 1e-5);
+  EXPECT_EQ(detections.boxes, (std::vector<float>{0, 0, 10, 10}));
+}
+
+TEST(CoreDetectionTests, LowObjectnessPassesWithUnnormalizedScores) {
+  // without the sigmoid, class scores may exceed 1: 0.2 * 4.0 passes a threshold of 0.5
+  const std::vector<float> rows = {
+      5, 5, 10, 10, 0.2F, 4.0F, 0.5F, //
+      50, 50, 10, 10, 0.1F, 2.0F, 1.0F,
+  };
+
+  DetectionConfig config;
+  config.num_classes = 2;
+  config.objectness_offset = 4;
+  config.class_offset = 5;
+  config.score_threshold = 0.5F;
+
+  const auto detections = postprocess_detections(rows, 2, config);
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections.labels[0], 0);
+  EXPECT_FLOAT_EQ(detections.scores[0], 0.8F);
+}
+
+TEST(CoreDetectionTests, AnchorDecoding) {
+  // zero deltas decode to the anchor itself
+  const std::vector<float> rows = {0, 0, 0, 0, 0.9F, 0.0F};
+
+  auto config = corners_config();
+  config.decoding = BoxDecoding::ANCHORS;
+  config.anchors = {0.5F, 0.5F, 0.2F, 0.4F};
+
+  const auto detections = postprocess_detections(rows, 1, config);
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_FLOAT_EQ(detections.boxes[0], 0.4F);
+  EXPECT_FLOAT_EQ(detections.boxes[1], 0.3F);
+  EXPECT_FLOAT_EQ(detections.boxes[2], 0.6F);
+  EXPECT_FLOAT_EQ(detections.boxes[3], 0.7F);
+}
+
+TEST(CoreDetectionTests, GridDecoding) {
+  // 16x8 input, strides 8 and 16: 2x1 + 1x1 = 3 rows
+  std::vector<float> rows(3 * 6, 0.0F);
+  rows[1 * 6 + 4] = 0.9F; // second cell of the stride-8 level
+  rows[1 * 6 + 0] = 0.5F;
+  rows[1 * 6 + 1] = 0.5F;
+
+  auto config = corners_config();
+  config.decoding = BoxDecoding::GRID;
+  config.input_width = 16;
+  config.input_height = 8;
+  config.strides = {8, 16};
+
+  const auto detections = postprocess_detections(rows, 3, config);
+  ASSERT_EQ(detections.size(), 1);
+  // center (1.5 * 8, 0.5 * 8) = (12, 4), size exp(0) * 8 = 8
+  EXPECT_EQ(detections.boxes, (std::vector<float>{8, 0, 16, 8}));
+}
+
+TEST(CoreDetectionTests, InvalidLayoutThrows) {
+  const std::vector<float> rows(6, 0.0F);
+
+  auto config = corners_config();
+  config.num_classes = 3;
+  EXPECT_THROW(postprocess_detections(rows, 1, config), std::invalid_argument);
+
+  config = corners_config();
+  config.decoding = BoxDecoding::GRID;
+  config.input_width = 64;
+  config.input_height = 64;
+  config.strides = {8};
+  EXPECT_THROW(postprocess_detections(rows, 1, config), std::invalid_argument);
+
+  EXPECT_THROW(postprocess_detections(std::vector<float>(7, 0.0F), 2, corners_config()), std::invalid_argument);
+
+  // offsets whose 32-bit sums would wrap around to a small value
+  config = corners_config();
+  config.box_offset = UINT32_MAX - 1;
+  EXPECT_THROW(postprocess_detections(rows, 1, config), std::invalid_argument);
+
+  config = corners_config();
+  config.class_offset = UINT32_MAX;
+  EXPECT_THROW(postprocess_detections(rows, 1, config), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "inference/core/hash.hpp"
+#include "inference/core/tensor_key.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+std::vector<uint8_t> make_bytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  return bytes;
+}
+
+} // namespace
+
+TEST(CoreHashTests, Deterministic) {
+  const auto bytes = make_bytes(4096);
+  EXPECT_EQ(hash_bytes(bytes.data(), bytes.size()), hash_bytes(bytes.data(), bytes.size()));
+}
+
+TEST(CoreHashTests, EmptyInput) {
+  EXPECT_EQ(hash_bytes(nullptr, 0), hash_bytes(nullptr, 0));
+  EXPECT_NE(hash_bytes(nullptr, 0), hash_bytes(nullptr, 0, 1));
+}
+
+TEST(CoreHashTests, DistinctPrefixLengths) {
+  // covers short, medium and long (multi-block) paths
+  const auto bytes = make_bytes(3000);
+  std::set<uint64_t> hashes;
+
+  for (size_t size = 0; size <= bytes.size(); ++size) {
+    hashes.insert(hash_bytes(bytes.data(), size));
+  }
+
+  EXPECT_EQ(hashes.size(), bytes.size() + 1);
+}
+
+TEST(CoreHashTests, SingleBitFlipChangesHash) {
+  auto bytes = make_bytes(2048 + 17);
+  const uint64_t base = hash_bytes(bytes.data(), bytes.size());
+
+  for (size_t i = 0; i < bytes.size(); i += 97) {
+    bytes[i] ^= 0x01;
+    EXPECT_NE(hash_bytes(bytes.data(), bytes.size()), base) << "byte " << i;
+    bytes[i] ^= 0x01;
+  }
+}
+
+TEST(CoreHashTests, UnalignedInput) {
+  const auto bytes = make_bytes(1000);
+  std::vector<uint8_t> shifted(bytes.size() + 3);
+  std::memcpy(shifted.data() + 3, bytes.data(), bytes.size());
+
+  EXPECT_EQ(hash_bytes(bytes.data(), bytes.size()), hash_bytes(shifted.data() + 3, bytes.size()));
+}
+
+TEST(CoreHashTests, SeedChangesHash) {
+  const auto bytes = make_bytes(256);
+  EXPECT_NE(hash_bytes(bytes.data(), bytes.size(), 0), hash_bytes(bytes.data(), bytes.size(), 42));
+}
+
+TEST(CoreHashTests, KnownAnswers) {
+  // Pins every code path (short <= 16, medium < 64, long stripes and 1 KiB blocks) to fixed values.
+  // Hashes are persisted as tuning-store keys, so the NEON, SSE2 and scalar builds must all produce
+  // these; the table was cross-checked against the scalar and portable-multiply builds.
+  struct KnownAnswer {
+    size_t size;
+    uint64_t hash;
+    uint64_t seeded; // seed 42
+  };
+  constexpr KnownAnswer kAnswers[] = {
+      {0, 0xDC78604D514032F8ULL, 0x267041CB7EB928E9ULL},
+      {1, 0x03BAAFB20E0D3733ULL, 0xC81A4691AF14A3D7ULL},
+      {3, 0x575ED6E717AB5A1AULL, 0xC049B2DB465B26A3ULL},
+      {4, 0x00DBAAD4187F96C0ULL, 0xB0F801FAA0CE1999ULL},
+      {7, 0xD84306A8D32143B1ULL, 0xF2A7D013669A0261ULL},
+      {8, 0x26383E24C4FF19C0ULL, 0x11BF30857417CBD1ULL},
+      {9, 0x850576593FFE85A3ULL, 0x5261A1FAE85010D8ULL},
+      {16, 0x6F96F3AEC145F5E0ULL, 0xBC6CA51743FC3EADULL},
+      {17, 0x30E041F0939B32EAULL, 0x48893DE5A83E02C4ULL},
+      {32, 0x5B48F466B90739F0ULL, 0x6CBA31F4A21F0D7EULL},
+      {63, 0x77CC2E177856FD18ULL, 0x2B46EC660A832F97ULL},
+      {64, 0x5F13587D6A0F3501ULL, 0x0844A6C84D4A86BBULL},
+      {65, 0x5A40CCEE8B5DE4FAULL, 0x22D7FB01C10EC591ULL},
+      {128, 0xF27994E9F7A1B60FULL, 0xE5FB2D063A830E0AULL},
+      {129, 0xDB19AB86A1A59636ULL, 0xFD8274A05AC0ADFFULL},
+      {200, 0x397D8F87E0D18B64ULL, 0xD25C485F6BBB2460ULL},
+      {240, 0x22BE1B33599AE3B6ULL, 0xE644EBC7B0B14ED6ULL},
+      {241, 0x6BFC29B39EDC5F0DULL, 0xC2D3E38D8060CC1FULL},
+      {1024, 0x8398122841697D00ULL, 0x0C2D8305C128C520ULL},
+      {1025, 0xF23A2EEFF68081E9ULL, 0xBC2FFE63ACA282C2ULL},
+      {3000, 0x7001FC29211EAE74ULL, 0x93B73F77631995B2ULL},
+  };
+
+  const auto bytes = make_bytes(3000);
+  for (const auto &answer : kAnswers) {
+    EXPECT_EQ(hash_bytes(bytes.data(), answer.size), answer.hash) << "size " << answer.size;
+    EXPECT_EQ(hash_bytes(bytes.data(), answer.size, 42), answer.seeded) << "size " << answer.size;
+  }
+}
+
+TEST(CoreTensorKeyTests, ShapeAndDtypeAreSignificant) {
+  const std::vector<float> data(12, 1.0F);
+  const size_t bytes = data.size() * sizeof(float);
+
+  const auto a = make_tensor_key(data.data(), bytes, {3, 4}, types::DataType::FLOAT32);
+  const auto b = make_tensor_key(data.data(), bytes, {4, 3}, types::DataType::FLOAT32);
+  const auto c = make_tensor_key(data.data(), bytes, {3, 4}, types::DataType::UINT8);
+  const auto d = make_tensor_key(data.data(), bytes, {3, 4}, types::DataType::FLOAT32);
+
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(a, d);
+  EXPECT_EQ(TensorKeyHash{}(a), TensorKeyHash{}(d));
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/core/image.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+// 2-channel NCHW ramp: channel c, pixel (x, y) = c * 100 + y * width + x
+std::vector<float> ramp(uint32_t width, uint32_t height, uint32_t channels) {
+  std::vector<float> data(static_cast<size_t>(width) * height * channels);
+  for (uint32_t c = 0; c < channels; c++) {
+    for (uint32_t y = 0; y < height; y++) {
+      for (uint32_t x = 0; x < width; x++) {
+        data[(c * height + y) * width + x] = static_cast<float>(c * 100 + y * width + x);
+      }
+    }
+  }
+  return data;
+}
+
+Roi full(uint32_t width, uint32_t height) { return {0.0F, 0.0F, static_cast<float>(width), static_cast<float>(height)}; }
+
+} // namespace
+
+TEST(CoreImageTests, IdentityResize) {
+  const auto data = ramp(4, 3, 2);
+  const ImageView image{.data = data, .width = 4, .height = 3, .channels = 2};
+
+  std::vector<float> out(data.size());
+  crop_resize_normalize(image, full(4, 3), 4, 3, types::Layout::NCHW, {}, out.data());
+
+  EXPECT_EQ(out, data);
+}
+
+TEST(CoreImageTests, DownscaleAveragesNeighbours) {
+  const std::vector<float> data = {
+      0, 2, //
+      4, 6,
+  };
+  const ImageView image{.data = data, .width = 2, .height = 2, .channels = 1};
+
+  float out = 0.0F;
+  crop_resize_normalize(image, full(2, 2), 1, 1, types::Layout::NCHW, {}, &out);
+
+  EXPECT_FLOAT_EQ(out, 3.0F);
+}
+
+TEST(CoreImageTests, CropsRoi) {
+  const auto data = ramp(4, 4, 1);
+  const ImageView image{.data = data, .width = 4, .height = 4, .channels = 1};
+
+  std::vector<float> out(4);
+  crop_resize_normalize(image, {2.0F, 1.0F, 4.0F, 3.0F}, 2, 2, types::Layout::NCHW, {}, out.data());
+
+  EXPECT_EQ(out, (std::vector<float>{6, 7, 10, 11}));
+}
+
+TEST(CoreImageTests, ConvertsLayout) {
+  const auto planar = ramp(3, 2, 2);
+  const ImageView image{.data = planar, .width = 3, .height = 2, .channels = 2};
+
+  std::vector<float> interleaved(planar.size());
+  crop_resize_normalize(image, full(3, 2), 3, 2, types::Layout::NHWC, {}, interleaved.data());
+
+  EXPECT_EQ(interleaved, (std::vector<float>{0, 100, 1, 101, 2, 102, 3, 103, 4, 104, 5, 105}));
+
+  // and back
+  const ImageView image_nhwc{.data = interleaved, .width = 3, .height = 2, .channels = 2, .layout = types::Layout::NHWC};
+
+  std::vector<float> out(planar.size());
+  crop_resize_normalize(image_nhwc, full(3, 2), 3, 2, types::Layout::NCHW, {}, out.data());
+
+  EXPECT_EQ(out, planar);
+}
+
+TEST(CoreImageTests, Normalizes) {
+  const auto data = ramp(1, 1, 2);
+  const ImageView image{.data = data, .width = 1, .height = 1, .channels = 2};
+
+  std::vector<float> out(2);
+  crop_resize_normalize(image, full(1, 1), 1, 1, types::Layout::NCHW, {.mean = {1.0F, 50.0F}, .std = {2.0F, 10.0F}},
+                        out.data());
+
+  EXPECT_FLOAT_EQ(out[0], -0.5F);
+  EXPECT_FLOAT_EQ(out[1], 5.0F);
+}
+
+TEST(CoreImageTests, ClampsOutsideImage) {
+  const std::vector<float> data = {1, 2};
+  const ImageView image{.data = data, .width = 2, .height = 1, .channels = 1};
+
+  std::vector<float> out(2);
+  crop_resize_normalize(image, {-10.0F, -10.0F, -8.0F, 10.0F}, 2, 1, types::Layout::NCHW, {}, out.data());
+
+  EXPECT_EQ(out, (std::vector<float>{1, 1}));
+}
+
+TEST(CoreImageTests, InvalidArguments) {
+  const auto data = ramp(2, 2, 3);
+  const ImageView image{.data = data, .width = 2, .height = 2, .channels = 3};
+  std::vector<float> out(12);
+
+  EXPECT_THROW(crop_resize_normalize(image, full(2, 2), 0, 2, types::Layout::NCHW, {}, out.data()),
+               std::invalid_argument);
+  EXPECT_THROW(
+      crop_resize_normalize(image, full(2, 2), 2, 2, types::Layout::NCHW, {.mean = {0.0F}, .std = {}}, out.data()),
+      std::invalid_argument);
+
+  // a zero std would divide by zero
+  EXPECT_THROW(crop_resize_normalize(image, full(2, 2), 2, 2, types::Layout::NCHW,
+                                     {.mean = {0.0F, 0.0F, 0.0F}, .std = {1.0F, 0.0F, 1.0F}}, out.data()),
+               std::invalid_argument);
+
+  // e.g. a detector box decoded from NaN or infinite outputs
+  for (const float bad : {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity()}) {
+    EXPECT_THROW(crop_resize_normalize(image, {bad, 0.0F, 2.0F, 2.0F}, 2, 2, types::Layout::NCHW, {}, out.data()),
+                 std::invalid_argument);
+    EXPECT_THROW(crop_resize_normalize(image, {0.0F, 0.0F, 2.0F, -bad}, 2, 2, types::Layout::NCHW, {}, out.data()),
+                 std::invalid_argument);
+  }
+
+  const ImageView truncated{.data = std::span(data).first(5), .width = 2, .height = 2, .channels = 3};
+  EXPECT_THROW(crop_resize_normalize(truncated, full(2, 2), 2, 2, types::Layout::NCHW, {}, out.data()),
+               std::invalid_argument);
+}
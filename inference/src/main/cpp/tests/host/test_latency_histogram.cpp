@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "inference/core/latency_histogram.hpp"
+
+using namespace inference::core;
+
+TEST(CoreLatencyHistogramTests, EmptySnapshot) {
+  LatencyHistogram histogram;
+  const auto snapshot = histogram.snapshot();
+
+  EXPECT_EQ(snapshot.count, 0);
+  EXPECT_EQ(snapshot.min, 0);
+  EXPECT_EQ(snapshot.quantile(0.99), 0);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 0.0);
+}
+
+TEST(CoreLatencyHistogramTests, BucketsAreContiguous) {
+  for (size_t i = 0; i + 1 < LatencyHistogram::kBucketCount; ++i) {
+    const uint64_t upper = LatencyHistogram::bucket_upper(i);
+    ASSERT_EQ(LatencyHistogram::bucket_index(upper), i);
+    ASSERT_EQ(LatencyHistogram::bucket_index(upper + 1), i + 1);
+  }
+
+  EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(CoreLatencyHistogramTests, RelativeErrorIsBounded) {
+  for (uint64_t value = 1; value < (uint64_t{1} << 39); value = value * 3 + 1) {
+    const uint64_t upper = LatencyHistogram::bucket_upper(LatencyHistogram::bucket_index(value));
+    ASSERT_GE(upper, value);
+    ASSERT_LE(static_cast<double>(upper - value), static_cast<double>(value) / 32.0);
+  }
+}
+
+TEST(CoreLatencyHistogramTests, Quantiles) {
+  LatencyHistogram histogram;
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.record(value * 1000);
+  }
+
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 1000);
+  EXPECT_EQ(snapshot.min, 1000);
+  EXPECT_EQ(snapshot.max, 1000000);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 500500.0);
+
+  const auto near = [](uint64_t actual, uint64_t expected) {
+    return actual >= expected && static_cast<double>(actual - expected) <= static_cast<double>(expected) / 32.0;
+  };
+
+  EXPECT_TRUE(near(snapshot.quantile(0.5), 500000));
+  EXPECT_TRUE(near(snapshot.quantile(0.99), 990000));
+  EXPECT_EQ(snapshot.quantile(1.0), 1000000);
+  EXPECT_EQ(snapshot.quantile(0.0), 1000);
+}
+
+TEST(CoreLatencyHistogramTests, MergeAndReset) {
+  LatencyHistogram a;
+  LatencyHistogram b;
+  a.record(10);
+  b.record(5);
+  b.record(20);
+
+  auto merged = a.snapshot();
+  merged.merge(b.snapshot());
+
+  EXPECT_EQ(merged.count, 3);
+  EXPECT_EQ(merged.sum, 35);
+  EXPECT_EQ(merged.min, 5);
+  EXPECT_EQ(merged.max, 20);
+  EXPECT_EQ(merged.quantile(0.5), 10);
+
+  a.reset();
+  EXPECT_EQ(a.snapshot().count, 0);
+}
+
+TEST(CoreLatencyHistogramTests, ConcurrentRecords) {
+  LatencyHistogram histogram;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram] {
+      for (uint64_t i = 0; i < 10000; ++i) {
+        histogram.record(i);
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 40000);
+  EXPECT_EQ(snapshot.max, 9999);
+  EXPECT_EQ(snapshot.min, 0);
+}
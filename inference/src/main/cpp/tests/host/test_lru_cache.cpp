@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inference/core/lru_cache.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+using StringCache = LruCache<int, std::string>;
+
+StringCache::ValuePtr value(const char *str) { return std::make_shared<const std::string>(str); }
+
+} // namespace
+
+TEST(CoreLruCacheTests, HitAndMiss) {
+  StringCache cache{4, 0};
+
+  EXPECT_EQ(cache.get(1), nullptr);
+  cache.put(1, value("one"), 3);
+
+  auto hit = cache.get(1);
+  ASSERT_NE(hit, nullptr);
+  EXPECT_EQ(*hit, "one");
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.entries, 1);
+  EXPECT_EQ(stats.bytes, 3);
+}
+
+TEST(CoreLruCacheTests, EvictsLeastRecentlyUsedByEntries) {
+  StringCache cache{2, 0};
+
+  cache.put(1, value("one"), 1);
+  cache.put(2, value("two"), 1);
+  EXPECT_NE(cache.get(1), nullptr); // 2 becomes the LRU entry
+  cache.put(3, value("three"), 1);
+
+  EXPECT_NE(cache.get(1), nullptr);
+  EXPECT_EQ(cache.get(2), nullptr);
+  EXPECT_NE(cache.get(3), nullptr);
+  EXPECT_EQ(cache.stats().evictions, 1);
+}
+
+TEST(CoreLruCacheTests, EvictsByBytes) {
+  StringCache cache{0, 10};
+
+  cache.put(1, value("a"), 4);
+  cache.put(2, value("b"), 4);
+  cache.put(3, value("c"), 4);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.entries, 2);
+  EXPECT_EQ(stats.bytes, 8);
+  EXPECT_EQ(cache.get(1), nullptr);
+}
+
+TEST(CoreLruCacheTests, RejectsOversizedValue) {
+  StringCache cache{0, 10};
+  cache.put(1, value("huge"), 11);
+  EXPECT_EQ(cache.stats().entries, 0);
+}
+
+TEST(CoreLruCacheTests, ReplaceUpdatesCost) {
+  StringCache cache{0, 0};
+  cache.put(1, value("a"), 4);
+  cache.put(1, value("b"), 6);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.entries, 1);
+  EXPECT_EQ(stats.bytes, 6);
+  EXPECT_EQ(*cache.get(1), "b");
+}
+
+TEST(CoreLruCacheTests, EvictedValueOutlivesCache) {
+  StringCache cache{1, 0};
+  cache.put(1, value("one"), 1);
+
+  auto held = cache.get(1);
+  cache.put(2, value("two"), 1);
+
+  EXPECT_EQ(cache.get(1), nullptr);
+  EXPECT_EQ(*held, "one");
+}
+
+TEST(CoreLruCacheTests, ConcurrentAccess) {
+  StringCache cache{64, 0};
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t] {
+      for (int i = 0; i < 1000; ++i) {
+        const int key = (i + t) % 128;
+        if (!cache.get(key)) {
+          cache.put(key, value("v"), 1);
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.hits + stats.misses, 4000);
+  EXPECT_LE(stats.entries, 64);
+}
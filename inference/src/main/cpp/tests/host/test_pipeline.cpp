@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/mock_backend.hpp"
+#include "inference/pipeline.hpp"
+
+using namespace inference;
+
+namespace {
+
+// mock detector: a uniform input v gives a single row (v, v+1, v+2, v+3, v+4, v+5),
+// i.e. the box (v, v+1, v+2, v+3) with class scores (v+4, v+5)
+std::shared_ptr<Context> make_detector(MockBackend **backend = nullptr) {
+  core::DetectionConfig detection;
+  detection.num_classes = 2;
+  detection.box_format = core::BoxFormat::CORNERS;
+  detection.score_threshold = 1.0F;
+
+  ModelConfig config;
+  config.detection = detection;
+
+  auto mock = std::make_unique<MockBackend>(MockConfig{.output_size = 6});
+  if (backend != nullptr) {
+    *backend = mock.get();
+  }
+  return std::make_shared<Context>(std::move(config), std::move(mock));
+}
+
+std::shared_ptr<Context> make_classifier(MockBackend **backend) {
+  auto mock = std::make_unique<MockBackend>(MockConfig{.output_size = 3});
+  *backend = mock.get();
+  return std::make_shared<Context>(ModelConfig{}, std::move(mock));
+}
+
+PipelineConfig make_config() {
+  PipelineConfig config;
+  config.detector_width = 8;
+  config.detector_height = 8;
+  config.detector_norm = {.mean = {0.5F, 0.5F, 0.5F}, .std = {1.0F, 1.0F, 1.0F}};
+  config.crop_width = 4;
+  config.crop_height = 2;
+  return config;
+}
+
+Tensor make_image(float value) {
+  Tensor tensor;
+  tensor.shape = {1, 3, 16, 16};
+  tensor.data.assign(3 * 16 * 16, value);
+  return tensor;
+}
+
+} // namespace
+
+TEST(PipelineTests, DetectsAndClassifies) {
+  MockBackend *classifier_backend = nullptr;
+  Pipeline pipeline{make_detector(), make_classifier(&classifier_backend), make_config()};
+
+  const auto image = make_image(0.5F);
+  const auto result = pipeline.run(as_view(image));
+
+  // detector input is normalized to zeros: box (0, 1, 2, 3) in 8x8, label 1
+  ASSERT_EQ(result.detections.size(), 1);
+  EXPECT_EQ(result.detections.labels[0], 1);
+  EXPECT_FLOAT_EQ(result.detections.scores[0], 5.0F);
+  EXPECT_EQ(result.detections.boxes, (std::vector<float>{0, 2, 4, 6}));
+
+  // crops are not normalized: mean 0.5
+  EXPECT_EQ(classifier_backend->predict_calls(), 1);
+  EXPECT_EQ(classifier_backend->samples(), 1);
+  EXPECT_EQ(result.classifications.shape, (Shape{1, 3}));
+  EXPECT_EQ(result.classifications.data, (std::vector<float>{0.5F, 1.5F, 2.5F}));
+  EXPECT_EQ(result.class_labels, (std::vector<std::uint32_t>{2}));
+  EXPECT_EQ(result.class_scores, (std::vector<float>{2.5F}));
+}
+
+TEST(PipelineTests, NoDetectionsSkipsClassifier) {
+  MockBackend *classifier_backend = nullptr;
+  auto config = make_config();
+  config.max_crops = 0;
+  Pipeline pipeline{make_detector(), make_classifier(&classifier_backend), config};
+
+  const auto image = make_image(0.5F);
+  const auto result = pipeline.run(as_view(image));
+
+  EXPECT_EQ(result.detections.size(), 0);
+  EXPECT_TRUE(result.classifications.data.empty());
+  EXPECT_EQ(classifier_backend->predict_calls(), 0);
+}
+
+TEST(PipelineTests, NhwcLayout) {
+  MockBackend *detector_backend = nullptr;
+  MockBackend *classifier_backend = nullptr;
+  auto config = make_config();
+  config.layout = core::types::Layout::NHWC;
+  Pipeline pipeline{make_detector(&detector_backend), make_classifier(&classifier_backend), config};
+
+  Tensor image = make_image(0.5F);
+  image.shape = {1, 16, 16, 3};
+  const auto result = pipeline.run(as_view(image));
+
+  ASSERT_EQ(result.detections.size(), 1);
+  EXPECT_EQ(detector_backend->samples(), 1);
+  EXPECT_EQ(classifier_backend->samples(), 1);
+}
+
+TEST(PipelineTests, InvalidArguments) {
+  MockBackend *classifier_backend = nullptr;
+  EXPECT_THROW(Pipeline(nullptr, make_classifier(&classifier_backend), make_config()), std::invalid_argument);
+  EXPECT_THROW(Pipeline(make_detector(), make_classifier(&classifier_backend), PipelineConfig{}),
+               std::invalid_argument);
+
+  Pipeline pipeline{make_detector(), make_classifier(&classifier_backend), make_config()};
+  Tensor image = make_image(0.5F);
+  image.shape = {2, 3, 16, 8};
+  EXPECT_THROW(pipeline.run(as_view(image)), std::runtime_error);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "inference/core/tensor_dataset.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / ("inference_" + name + ".tds")).string();
+}
+
+} // namespace
+
+TEST(CoreTensorDatasetTests, RoundTrip) {
+  const auto path = temp_path("round_trip");
+
+  const std::vector<float> a = {1, 2, 3, 4, 5, 6};
+  const std::vector<uint8_t> b = {7, 8, 9};
+
+  {
+    TensorDatasetWriter writer{path};
+    writer.append(a, {1, 2, 3}, types::Layout::NCHW);
+    writer.append(b, {3}, types::Layout::UNDEFINED, types::DataType::UINT8);
+    writer.append(std::span<const float>{}, {0, 4});
+    EXPECT_EQ(writer.size(), 3);
+    writer.finish();
+  }
+
+  TensorDataset dataset{path};
+  ASSERT_EQ(dataset.size(), 3);
+
+  const auto first = dataset.record(0);
+  EXPECT_EQ(first.shape, (types::Shape{1, 2, 3}));
+  EXPECT_EQ(first.layout, types::Layout::NCHW);
+  EXPECT_EQ(first.dtype, types::DataType::FLOAT32);
+  EXPECT_EQ(std::vector<float>(first.floats().begin(), first.floats().end()), a);
+
+  const auto second = dataset.record(1);
+  EXPECT_EQ(second.dtype, types::DataType::UINT8);
+  EXPECT_EQ(std::vector<uint8_t>(second.bytes.begin(), second.bytes.end()), b);
+  EXPECT_THROW(second.floats(), std::runtime_error);
+
+  const auto third = dataset.record(2);
+  EXPECT_EQ(third.shape, (types::Shape{0, 4}));
+  EXPECT_TRUE(third.bytes.empty());
+
+  EXPECT_THROW(dataset.record(3), std::out_of_range);
+  dataset.prefetch(0, 10); // best effort, clamped
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTensorDatasetTests, PayloadsAreAlignedViewsIntoTheMapping) {
+  const auto path = temp_path("aligned");
+
+  {
+    TensorDatasetWriter writer{path};
+    for (uint32_t i = 1; i <= 5; ++i) {
+      const std::vector<float> data(i * 3, static_cast<float>(i));
+      writer.append(data, {i, 3});
+    }
+    writer.finish();
+  }
+
+  TensorDataset dataset{path};
+  for (size_t i = 0; i < dataset.size(); ++i) {
+    const auto record = dataset.record(i);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(record.bytes.data()) % dataset::kAlignment, 0);
+    EXPECT_FLOAT_EQ(record.floats()[0], static_cast<float>(i + 1));
+  }
+
+  // views are stable across lookups (no copies)
+  EXPECT_EQ(dataset.record(2).bytes.data(), dataset.record(2).bytes.data());
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTensorDatasetTests, WriterRejectsInvalidRecords) {
+  const auto path = temp_path("invalid_records");
+  TensorDatasetWriter writer{path};
+
+  const std::vector<float> data(4);
+  EXPECT_THROW(writer.append(data, {5}), std::invalid_argument);
+  EXPECT_THROW(writer.append(data, {1, 1, 1, 1, 1, 1, 1, 1, 4}), std::invalid_argument);
+
+  writer.finish();
+  EXPECT_THROW(writer.append(data, {4}), std::logic_error);
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTensorDatasetTests, ReaderRejectsMalformedFiles) {
+  const auto path = temp_path("malformed");
+
+  EXPECT_THROW(TensorDataset{temp_path("missing")}, std::runtime_error);
+
+  {
+    std::ofstream out{path, std::ios::binary};
+    out << "not a dataset";
+  }
+  EXPECT_THROW(TensorDataset{path}, std::runtime_error);
+
+  {
+    TensorDatasetWriter writer{path};
+    const std::vector<float> data(64, 1.0F);
+    writer.append(data, {64});
+    writer.finish();
+  }
+
+  // cut the file inside the index table
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+  EXPECT_THROW(TensorDataset{path}, std::runtime_error);
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTensorDatasetTests, ReaderRejectsUnfinishedFiles) {
+  const auto path = temp_path("unfinished");
+  {
+    TensorDatasetWriter writer{path};
+    const std::vector<float> data(64, 1.0F);
+    writer.append(data, {64});
+    // destroyed without finish(), as when a producer throws
+  }
+  EXPECT_THROW(TensorDataset{path}, std::runtime_error);
+
+  std::filesystem::remove(path);
+}
+
+TEST(CoreTensorDatasetTests, ReaderRejectsOutOfOrderRecords) {
+  const auto path = temp_path("out_of_order");
+  {
+    TensorDatasetWriter writer{path};
+    const std::vector<float> data(64, 1.0F);
+    writer.append(data, {64});
+    writer.append(data, {64});
+    writer.finish();
+  }
+  ASSERT_NO_THROW(TensorDataset{path});
+
+  // swap the two index entries: both records stay in bounds, but the second precedes the first
+  {
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    uint64_t index_offset = 0;
+    file.seekg(24); // magic, version, reserved, count
+    file.read(reinterpret_cast<char *>(&index_offset), sizeof(index_offset));
+
+    std::array<uint64_t, 2> offsets{};
+    file.seekg(static_cast<std::streamoff>(index_offset));
+    file.read(reinterpret_cast<char *>(offsets.data()), sizeof(offsets));
+    std::swap(offsets[0], offsets[1]);
+    file.seekp(static_cast<std::streamoff>(index_offset));
+    file.write(reinterpret_cast<const char *>(offsets.data()), sizeof(offsets));
+    ASSERT_TRUE(file.good());
+  }
+  EXPECT_THROW(TensorDataset{path}, std::runtime_error);
+
+  std::filesystem::remove(path);
+}
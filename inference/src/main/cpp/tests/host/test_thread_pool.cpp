@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/core/thread_pool.hpp"
+
+using namespace inference::core;
+
+TEST(CoreThreadPoolTests, SubmitReturnsResult) {
+  ThreadPool pool{2};
+  auto future = pool.submit([] { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(CoreThreadPoolTests, SubmitPropagatesException) {
+  ThreadPool pool{1};
+  auto future = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(CoreThreadPoolTests, ZeroSelectsHardwareConcurrency) {
+  ThreadPool pool{0};
+  EXPECT_GE(pool.size(), 1);
+}
+
+TEST(CoreThreadPoolTests, ParallelForCoversRangeOnce) {
+  ThreadPool pool{3};
+  std::vector<std::atomic<int>> visits(1000);
+
+  pool.parallel_for(visits.size(), 10, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      visits[i]++;
+    }
+  });
+
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(CoreThreadPoolTests, ParallelForRethrows) {
+  ThreadPool pool{2};
+  EXPECT_THROW(pool.parallel_for(100, 1,
+                                 [](size_t begin, size_t /*end*/) {
+                                   if (begin > 0) {
+                                     throw std::runtime_error("chunk failed");
+                                   }
+                                 }),
+               std::runtime_error);
+}
+
+TEST(CoreThreadPoolTests, DestructorDrainsQueue) {
+  std::atomic<int> done{0};
+  {
+    ThreadPool pool{1};
+    for (int i = 0; i < 100; ++i) {
+      pool.submit([&done] { done++; });
+    }
+  }
+  EXPECT_EQ(done.load(), 100);
+}
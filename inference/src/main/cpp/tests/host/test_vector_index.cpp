@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "inference/core/vector_index.hpp"
+
+using namespace inference::core;
+
+namespace {
+
+std::vector<std::vector<float>> random_vectors(size_t count, uint32_t dim, uint32_t seed) {
+  std::mt19937 rng{seed};
+  std::normal_distribution<float> dist{0.0F, 1.0F};
+
+  std::vector<std::vector<float>> vectors(count, std::vector<float>(dim));
+  for (auto &vector : vectors) {
+    for (float &value : vector) {
+      value = dist(rng);
+    }
+  }
+  return vectors;
+}
+
+double cosine(const std::vector<float> &a, const std::vector<float> &b) {
+  double dot = 0.0, na = 0.0, nb = 0.0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    dot += a[i] * b[i];
+    na += a[i] * a[i];
+    nb += b[i] * b[i];
+  }
+  return dot / std::sqrt(na * nb);
+}
+
+double l2(const std::vector<float> &a, const std::vector<float> &b) {
+  double sum = 0.0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    sum += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return std::sqrt(sum);
+}
+
+std::unique_ptr<VectorIndex> make_index(const std::vector<std::vector<float>> &vectors, VectorIndexConfig config) {
+  auto index = std::make_unique<VectorIndex>(config);
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    index->add(static_cast<uint32_t>(i), vectors[i]);
+  }
+  return index;
+}
+
+} // namespace
+
+TEST(CoreVectorIndexTests, RejectsInvalidConfig) {
+  EXPECT_THROW(VectorIndex({.dim = 0}), std::invalid_argument);
+  EXPECT_THROW(VectorIndex({.dim = 4, .storage = types::DataType::UINT8}), std::invalid_argument);
+}
+
+TEST(CoreVectorIndexTests, RejectsDimensionMismatch) {
+  VectorIndex index{{.dim = 4}};
+  const std::vector<float> vector(3, 1.0F);
+  EXPECT_THROW(index.add(0, vector), std::invalid_argument);
+  EXPECT_THROW(index.query(vector, 1), std::invalid_argument);
+}
+
+TEST(CoreVectorIndexTests, CosineMatchesBruteForce) {
+  const auto vectors = random_vectors(500, 67, 1); // odd dim exercises the scalar tail
+  const auto query = random_vectors(1, 67, 2)[0];
+  const auto index = make_index(vectors, {.dim = 67, .metric = Metric::COSINE});
+
+  const auto results = index->query(query, 5);
+  ASSERT_EQ(results.size(), 5);
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_NEAR(results[i].score, cosine(query, vectors[results[i].id]), 1e-4);
+    if (i > 0) {
+      EXPECT_GE(results[i - 1].score, results[i].score);
+    }
+  }
+
+  // best result is the true nearest neighbour
+  size_t best = 0;
+  for (size_t i = 1; i < vectors.size(); ++i) {
+    if (cosine(query, vectors[i]) > cosine(query, vectors[best])) {
+      best = i;
+    }
+  }
+  EXPECT_EQ(results[0].id, best);
+}
+
+TEST(CoreVectorIndexTests, L2MatchesBruteForce) {
+  const auto vectors = random_vectors(300, 32, 3);
+  const auto index = make_index(vectors, {.dim = 32, .metric = Metric::L2});
+
+  const auto results = index->query(vectors[17], 3);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(results[0].id, 17);
+  EXPECT_NEAR(results[0].score, 0.0F, 1e-2);
+
+  for (size_t i = 1; i < results.size(); ++i) {
+    EXPECT_NEAR(results[i].score, l2(vectors[17], vectors[results[i].id]), 1e-3);
+    EXPECT_LE(results[i - 1].score, results[i].score);
+  }
+}
+
+TEST(CoreVectorIndexTests, Int8StorageApproximatesFloat) {
+  const auto vectors = random_vectors(400, 128, 4);
+  const auto query = random_vectors(1, 128, 5)[0];
+
+  const auto exact = make_index(vectors, {.dim = 128});
+  const auto quantized = make_index(vectors, {.dim = 128, .storage = types::DataType::INT8});
+
+  const auto expected = exact->query(query, 1);
+  const auto actual = quantized->query(query, 10);
+
+  ASSERT_EQ(actual.size(), 10);
+  EXPECT_NEAR(actual[0].score, expected[0].score, 0.02);
+
+  bool found = false;
+  for (const auto &result : actual) {
+    found = found || result.id == expected[0].id;
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(CoreVectorIndexTests, ParallelQueryMatchesSerial) {
+  const auto vectors = random_vectors(4000, 64, 6);
+  const auto query = random_vectors(1, 64, 7)[0];
+
+  const auto serial = make_index(vectors, {.dim = 64, .threads = 1});
+  const auto parallel = make_index(vectors, {.dim = 64, .threads = 4});
+
+  const auto expected = serial->query(query, 20);
+  const auto actual = parallel->query(query, 20);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_EQ(actual[i].id, expected[i].id);
+    EXPECT_FLOAT_EQ(actual[i].score, expected[i].score);
+  }
+}
+
+TEST(CoreVectorIndexTests, RemoveAndReplace) {
+  VectorIndex index{{.dim = 2, .metric = Metric::L2, .storage = types::DataType::INT8}};
+  index.add(10, std::vector<float>{0.0F, 0.0F});
+  index.add(20, std::vector<float>{5.0F, 5.0F});
+  index.add(30, std::vector<float>{9.0F, 9.0F});
+
+  EXPECT_TRUE(index.remove(10));
+  EXPECT_FALSE(index.remove(10));
+  EXPECT_EQ(index.size(), 2);
+
+  auto results = index.query(std::vector<float>{9.0F, 9.0F}, 5);
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].id, 30);
+  EXPECT_EQ(results[1].id, 20);
+
+  index.add(30, std::vector<float>{-1.0F, -1.0F}); // replace
+  EXPECT_EQ(index.size(), 2);
+
+  results = index.query(std::vector<float>{9.0F, 9.0F}, 1);
+  EXPECT_EQ(results[0].id, 20);
+}
+
+TEST(CoreVectorIndexTests, EmptyIndexReturnsNothing) {
+  VectorIndex index{{.dim = 3}};
+  EXPECT_TRUE(index.query(std::vector<float>{1.0F, 0.0F, 0.0F}, 5).empty());
+}
@@ -2,10 +2,109 @@ export type Shape = Uint32Array;
 
 export type Device = 'CPU' | 'MOCK'; // later: 'NPU'
 
+/** Opt-in result cache; identical inputs (same bytes, shape and dtype) skip predict */
+export interface CacheConfig {
+  maxEntries?: number; // max cached results (0 = unlimited)
+  maxBytes?: number; // max cached output bytes (0 = unlimited)
+}
+
+/** Opt-in dynamic micro-batching of concurrent single-sample run() calls */
+export interface BatchingConfig {
+  maxBatchSize: number; // max samples per batched predict (> 1 enables batching)
+  maxDelayMs?: number; // max time a request waits for others (default: 2 ms)
+}
+
+/** Execution resources of a context */
+export interface ExecutionConfig {
+  threads?: number; // backend threads per instance (default: 1)
+  instances?: number; // backend instances predicting concurrently, each with its own copy of the model (default: 1)
+}
+
+/**
+ * Self-tuning of execution and batching against a p99 latency target.
+ *
+ * Every candidate (threads x instances x batch size, never more threads in total than cores)
+ * is benchmarked under closed-loop load; the highest-throughput candidate whose p99 meets the
+ * target is applied, or the lowest-p99 one if none does.
+ */
+export interface AutotuneOptions {
+  targetP99Ms: number; // p99 latency target of run()
+  threads?: number[]; // candidates (default: powers of two up to the core count)
+  instances?: number[]; // candidates (default: [1, 2])
+  batchSizes?: number[]; // candidates, 1 = no batching (default: [1, 4, 8])
+  concurrency?: number; // concurrent benchmark requests (default: instances * batch size)
+  requests?: number; // measured runs per candidate (default: 200)
+  warmup?: number; // unmeasured runs per candidate (default: 20)
+  input?: InputTensor; // benchmark input [1, ...] (default: zeros; required if the model input shape is dynamic)
+}
+
+/** One benchmarked candidate */
+export interface AutotuneTrial {
+  threads: number;
+  instances: number;
+  maxBatchSize: number;
+  throughput: number; // runs per second
+  p99Ms: number;
+  meetsSlo: boolean;
+}
+
+/** The applied candidate and every benchmarked one */
+export interface AutotuneResult extends AutotuneTrial {
+  trials: AutotuneTrial[];
+}
+
+/**
+ * Detector postprocessing (score threshold, box decoding, NMS) run natively by detect().
+ *
+ * The model output is read as rows of [..box(4).., objectness?, ..classes(numClasses)..].
+ */
+export interface DetectionConfig {
+  numClasses: number;
+  boxOffset?: number; // default: 0
+  objectnessOffset?: number; // omitted: no objectness value
+  classOffset?: number; // default: 4
+  boxFormat?: 'corners' | 'center'; // x1,y1,x2,y2 or cx,cy,w,h (default: 'center')
+  anchors?: Float32Array; // SSD decoding: one (cx, cy, w, h) anchor per row
+  variances?: Float32Array; // SSD decoding variances (default: [0.1, 0.1, 0.2, 0.2])
+  grid?: { inputWidth: number; inputHeight: number; strides: Uint32Array }; // anchor-free grid decoding
+  sigmoid?: boolean; // objectness/class values are logits (default: false)
+  multiLabel?: boolean; // one candidate per class above threshold (default: false)
+  classAgnostic?: boolean; // suppress across classes (default: false)
+  scoreThreshold?: number; // default: 0.25
+  iouThreshold?: number; // default: 0.45
+  maxDetections?: number; // default: 100, 0 = unlimited
+  maxCandidates?: number; // top candidates considered by NMS (default: 4096, 0 = unlimited)
+}
+
+/** Final detections, best first */
+export interface Detections {
+  boxes: Float32Array; // x1, y1, x2, y2 per detection
+  scores: Float32Array;
+  labels: Uint32Array;
+}
+
 /** Config options required to load the inference model */
 export interface ModelConfig {
-  modelData: ArrayBuffer; // contains model binary data
+  // model source, exactly one of:
+  modelData?: ArrayBuffer; // model binary data, read without copying (do not detach until loading settles)
+  modelPath?: string; // model file path, read natively
   device: Device; // runtime device (e.g., CPU, MOCK)
+  outputName?: string; // return this named model output instead of the default one, e.g. embeddings
+  cache?: CacheConfig; // result cache, disabled when omitted
+  batching?: BatchingConfig; // micro-batching, disabled when omitted
+  detection?: DetectionConfig; // required by detect()
+  execution?: ExecutionConfig; // default: one instance with one thread
+  autotune?: AutotuneOptions; // tune execution and batching while loading (skipped if tuningCache has a result)
+  tuningCache?: string; // file of autotune results keyed by model hash and CPU; a stored result is applied on load
+}
+
+/** Result cache counters (all zero when the cache is disabled) */
+export interface CacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  entries: number; // currently cached results
+  bytes: number; // currently cached output bytes
 }
 
 /** Input tensor passed to native inference */
@@ -21,6 +120,21 @@ export interface OutputTensor {
   shape: Shape; // output tensor dimensions, e.g. [1, 1000]
 }
 
+/** Options of an offline dataset run */
+export interface DatasetRunOptions {
+  batchSize?: number; // records per run, [1, ...] records of one shape are stacked along dimension 0 (default: 1)
+  workers?: number; // concurrent runs (default: 1)
+  prefetch?: number; // batches read ahead of the workers (default: 4)
+  topK?: number; // write Int32 labels and Float32 scores of the k best values per row (default: 0 = full outputs)
+}
+
+/** Summary of a finished dataset run */
+export interface DatasetRunStats {
+  records: number;
+  batches: number;
+  seconds: number;
+}
+
 export interface InferenceContext {
   /**
    * Runs inference using the loaded model on the provided image tensor data.
@@ -32,6 +146,52 @@ export interface InferenceContext {
    * @throws {Error} An error if inference fails.
    */
   run(input: InputTensor): Promise<OutputTensor>;
+
+  /**
+   * Runs a detector and postprocesses its output natively (decode + NMS).
+   * Only the final boxes are copied back to JS.
+   *
+   * @param input A single image structured as an InputTensor (batch size 1).
+   * @returns A Promise that resolves with the final detections.
+   * @throws {Error} An error if the context has no detection config, the input is batched or inference fails.
+   */
+  detect(input: InputTensor): Promise<Detections>;
+
+  /**
+   * Returns a snapshot of the result cache counters.
+   *
+   * @returns Hit/miss statistics of the context's result cache.
+   */
+  cacheStats(): CacheStats;
+
+  /**
+   * Streams a memory-mapped tensor dataset file through the model natively and
+   * writes the outputs (or top-K) to a new dataset file, in input order.
+   * Records are preprocessed Float32 tensors; nothing is copied through JS.
+   *
+   * @param inputPath Path of the input dataset.
+   * @param outputPath Path of the output dataset (overwritten).
+   * @param options Batching, worker and output options.
+   * @returns A Promise that resolves with the run summary.
+   * @throws {Error} An error if a file is invalid or inference fails.
+   */
+  runDataset(inputPath: string, outputPath: string, options?: DatasetRunOptions): Promise<DatasetRunStats>;
+
+  /**
+   * Benchmarks execution and batching candidates on temporary copies of the model in the
+   * background, then switches this context to the best one (in-flight runs finish first).
+   * The result is saved to the context's tuningCache, if any, so later loads start tuned.
+   * Runs issued meanwhile are served but compete with the benchmark for CPU. Tuning runs of the
+   * process (including those started while loading) execute one at a time so they do not skew each other.
+   *
+   * A context loaded from modelData can only be tuned if it was created with autotune or
+   * tuningCache (which keep a native copy of the model).
+   *
+   * @param options The latency target and candidates.
+   * @returns A Promise that resolves with the applied configuration and all trials.
+   * @throws {Error} An error if the options are invalid or a candidate fails to load or run.
+   */
+  autotune(options: AutotuneOptions): Promise<AutotuneResult>;
 }
 
 /**
@@ -45,5 +205,120 @@ export interface InferenceContext {
  */
 export function createContext(config: ModelConfig): Promise<InferenceContext>;
 
+/** Progress of a createContexts() call, reported once per model */
+export interface LoadProgress {
+  index: number; // index of the model in the configs array
+  loaded: number; // models finished so far (including this one)
+  total: number;
+  error?: string; // set if this model failed to load
+}
 
+/**
+ * Create several contexts, loading and compiling the models in parallel (one loader thread per core).
+ *
+ * @param configs The configs of the models to load.
+ * @param onProgress Optional callback invoked on the JS thread as each model finishes.
+ * @returns A Promise that resolves with the contexts, in the order of `configs`.
+ * @throws {Error} An error if any model fails to load (listing every failure).
+ */
+export function createContexts(configs: ModelConfig[],
+  onProgress?: (progress: LoadProgress) => void): Promise<InferenceContext[]>;
+
+export type Metric = 'cosine' | 'l2';
+
+/** Config options of a native vector index */
+export interface VectorIndexConfig {
+  dim: number; // vector dimension
+  metric?: Metric; // default: 'cosine'
+  storage?: 'float32' | 'int8'; // int8 = quantized, 4x smaller, approximate scores (default: 'float32')
+  threads?: number; // threads per query, 0 = all cores (default: 1)
+}
+
+/** Nearest neighbours, best first */
+export interface SearchResults {
+  ids: Uint32Array;
+  scores: Float32Array; // cosine similarity (higher is closer) or L2 distance (lower is closer)
+}
+
+export interface VectorIndex {
+  /** Adds a vector, replacing any vector previously stored under the same id. */
+  add(id: number, vector: Float32Array): void;
+
+  /** Removes a vector; returns false if the id was not present. */
+  remove(id: number): boolean;
+
+  /** Number of stored vectors. */
+  size(): number;
+
+  /**
+   * Finds the k nearest stored vectors off the JS thread.
+   *
+   * @param vector Query vector of `dim` elements.
+   * @param k Maximum number of results.
+   * @returns A Promise that resolves with ids and scores, best first.
+   * @throws {Error} An error if the vector dimension does not match.
+   */
+  query(vector: Float32Array, k: number): Promise<SearchResults>;
+}
 
+/**
+ * Create an in-memory flat vector index (brute-force, SIMD-accelerated).
+ *
+ * @param config The index dimension, metric and storage options.
+ * @returns The index.
+ * @throws {Error} An error if the config is invalid.
+ */
+export function createVectorIndex(config: VectorIndexConfig): VectorIndex;
+
+/** Per-channel normalization: out = (value - mean[c]) / std[c] */
+export interface Normalization {
+  mean: Float32Array; // one value per channel
+  std: Float32Array; // one value per channel
+}
+
+export interface ImageSize {
+  width: number;
+  height: number;
+}
+
+/** Detector -> crop/resize -> classifier pipeline run natively on one image */
+export interface PipelineConfig {
+  detector: InferenceContext; // must have a detection config
+  classifier: InferenceContext;
+  layout?: 'NCHW' | 'NHWC'; // image and model input layout (default: 'NCHW')
+  detectorSize: ImageSize; // detector input size, the full image is resized to it
+  detectorNormalize?: Normalization; // default: none
+  normalizedBoxes?: boolean; // detector boxes are in [0, 1] instead of detector input pixels (default: false)
+  cropSize: ImageSize; // classifier input size, every box is resized to it
+  classifierNormalize?: Normalization; // default: none
+  cropPadding?: number; // box enlargement on each side, relative to the box size (default: 0)
+  maxCrops?: number; // best detections classified in one batch (default: 16)
+}
+
+/** Detections (boxes in input image pixels) with one classification per detection */
+export interface PipelineResult extends Detections {
+  classifications: OutputTensor; // classifier output, [count, ...]
+  classLabels: Uint32Array; // argmax of every classification
+  classScores: Float32Array; // max value of every classification
+}
+
+export interface Pipeline {
+  /**
+   * Detects objects, crops and resizes them from the input image and classifies
+   * all crops in one batched run, without returning to JS in between.
+   *
+   * @param image A single [1, C, H, W] (or [1, H, W, C]) image.
+   * @returns A Promise that resolves with the detections and their classifications.
+   * @throws {Error} An error if the image shape is invalid or inference fails.
+   */
+  run(image: InputTensor): Promise<PipelineResult>;
+}
+
+/**
+ * Create a native multi-model pipeline from loaded contexts.
+ *
+ * @param config The detector and classifier contexts and the image preprocessing options.
+ * @returns The pipeline.
+ * @throws {Error} An error if the config is invalid.
+ */
+export function createPipeline(config: PipelineConfig): Pipeline;